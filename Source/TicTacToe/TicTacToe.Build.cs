@@ -9,5 +9,8 @@ public class TicTacToe : ModuleRules
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay" });
+
+		// Match server and load test bots
+		PrivateDependencyModuleNames.AddRange(new string[] { "Sockets", "Networking" });
 	}
 }
@@ -0,0 +1,818 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeAI.h"
+#include "TicTacToeNTupleNetwork.h"
+#include "TicTacToeSymmetry.h"
+#include "TicTacToeTranspositionTable.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+
+namespace
+{
+	class FRandomEngine : public FTicTacToeEngine
+	{
+	public:
+		using FTicTacToeEngine::FTicTacToeEngine;
+
+		virtual int32 ChooseMove(const FTicTacToeBoard& Board, FRandomStream& Random, FTicTacToeSearchStats& OutStats) override
+		{
+			OutStats.Nodes++;
+			return RandomCell(Board.GetEmptyMask(), Random);
+		}
+	};
+
+	class FTacticalEngine : public FTicTacToeEngine
+	{
+	public:
+		using FTicTacToeEngine::FTicTacToeEngine;
+
+		virtual int32 ChooseMove(const FTicTacToeBoard& Board, FRandomStream& Random, FTicTacToeSearchStats& OutStats) override
+		{
+			OutStats.Nodes++;
+			const int32 Side = Board.GetSideToMove();
+
+			int32 Cell = FindWinningCell(Board, Side);
+			if (Cell == INDEX_NONE)
+			{
+				Cell = FindWinningCell(Board, Side ^ 1);
+			}
+			return Cell != INDEX_NONE ? Cell : RandomCell(Board.GetEmptyMask(), Random);
+		}
+	};
+
+	class FAlphaBetaEngine : public FTicTacToeEngine
+	{
+	public:
+		using FTicTacToeEngine::FTicTacToeEngine;
+
+		virtual int32 ChooseMove(const FTicTacToeBoard& Board, FRandomStream& Random, FTicTacToeSearchStats& OutStats) override
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			FTicTacToeBoard Work = Board;
+			BuildMoveOrder(Work);
+			bAborted = false;
+
+			// Leaves are scored by the trained network when there is one for this board
+			const FTicTacToeNTupleNetwork* Network = Settings.Type == ETicTacToeEngineType::NTuple ? FTicTacToeNTupleNetwork::FindTrained(Board.Size, Board.WinLength) : nullptr;
+			if (Network == nullptr)
+			{
+				NetworkState.Reset();
+			}
+			else
+			{
+				if (!NetworkState.IsValid() || &NetworkState->Network != Network)
+				{
+					NetworkState = MakeUnique<FTicTacToeNTupleState>(*Network);
+				}
+				NetworkState->SetPosition(Board);
+			}
+
+			TArray<int32, TInlineAllocator<64>> RootMoves;
+			for (int32 Cell : MoveOrder)
+			{
+				if (Work.IsEmpty(Cell))
+				{
+					RootMoves.Add(Cell);
+				}
+			}
+
+			// Iterative deepening, so a best move is ready whenever the search is stopped
+			int32 BestCell = RootMoves[0];
+			const int32 MaxDepth = FMath::Min(Settings.MaxDepth, RootMoves.Num());
+			for (int32 Depth = 1; Depth <= MaxDepth; Depth++)
+			{
+				// Search the previous best first, then every root move with a full window so equal scores can be tie-broken at random
+				RootMoves.Remove(BestCell);
+				RootMoves.Insert(BestCell, 0);
+
+				TArray<int32, TInlineAllocator<64>> BestCells;
+				int32 BestScore = -WinScore - 1;
+				for (int32 Cell : RootMoves)
+				{
+					MakeMove(Work, Cell);
+					const int32 Score = -Negamax(Work, Depth - 1, -WinScore - 1, WinScore + 1, 1, OutStats);
+					UndoMove(Work, Cell);
+
+					if (bAborted)
+						break;
+
+					if (Score > BestScore)
+					{
+						BestScore = Score;
+						BestCells.Reset();
+					}
+					if (Score == BestScore)
+					{
+						// Keep each tied move's line so whichever is picked can be reported
+						TArray<int32>& Line = RootLines[BestCells.Num()];
+						Line.Reset();
+						Line.Add(Cell);
+						Line.Append(&PV[1][1], PVLength[1] - 1);
+						BestCells.Add(Cell);
+					}
+				}
+
+				// An unfinished iteration is only trusted when nothing has been completed yet
+				if (bAborted)
+				{
+					if (Depth == 1 && BestCells.Num() > 0)
+					{
+						BestCell = BestCells[0];
+					}
+					break;
+				}
+
+				const int32 Picked = Random.RandHelper(BestCells.Num());
+				BestCell = BestCells[Picked];
+
+				if (Control)
+				{
+					FTicTacToeSearchProgress Progress;
+					Progress.PrincipalVariation = RootLines[Picked];
+					Progress.Depth = Depth;
+					Progress.Nodes = OutStats.Nodes;
+					Progress.Seconds = FPlatformTime::Seconds() - StartTime;
+					Progress.Score = BestScore;
+					Progress.BestMove = BestCell;
+					Control->ReportProgress(Progress);
+				}
+
+				// A proven result will not change with more depth
+				if (FMath::Abs(BestScore) >= WinScore - 100)
+					break;
+			}
+			return BestCell;
+		}
+
+	private:
+
+		/** Cells sorted by how many lines pass through them, so central cells are tried first */
+		TArray<int32, TInlineAllocator<64>> MoveOrder;
+
+		/** Principal variation found below each ply, PV[Ply][Ply] being that ply's best move */
+		int32 PV[65][65];
+		int32 PVLength[65];
+
+		/** Principal variations of the root moves tied for best in the current iteration */
+		TArray<int32> RootLines[64];
+
+		/** Set once the search control asks to stop, unwinding the search */
+		bool bAborted;
+
+		/** The network's view of the searched position, null when leaves use the static evaluation */
+		TUniquePtr<FTicTacToeNTupleState> NetworkState;
+
+		/** Network value of a certain win, kept well below WinScore */
+		static constexpr float NetworkScale = 10000.f;
+
+		FORCEINLINE void MakeMove(FTicTacToeBoard& Board, int32 Cell)
+		{
+			if (NetworkState.IsValid())
+			{
+				NetworkState->MakeMove(Cell, Board.GetSideToMove());
+			}
+			Board.MakeMove(Cell);
+		}
+
+		FORCEINLINE void UndoMove(FTicTacToeBoard& Board, int32 Cell)
+		{
+			Board.UndoMove(Cell);
+			if (NetworkState.IsValid())
+			{
+				NetworkState->UndoMove(Cell, Board.GetSideToMove());
+			}
+		}
+
+		/** Leaf score for the side to move */
+		FORCEINLINE int32 EvaluateLeaf(const FTicTacToeBoard& Board) const
+		{
+			if (!NetworkState.IsValid())
+				return Evaluate(Board);
+
+			const float Value = NetworkState->GetValue();
+			return FMath::RoundToInt((Board.GetSideToMove() == 0 ? Value : -Value) * NetworkScale);
+		}
+
+		void BuildMoveOrder(const FTicTacToeBoard& Board)
+		{
+			if (MoveOrder.Num() == Board.NumCells)
+				return;
+
+			const FTicTacToeLineTable& Lines = Board.GetLines();
+			MoveOrder.Reset();
+			for (int32 Cell = 0; Cell < Board.NumCells; Cell++)
+			{
+				MoveOrder.Add(Cell);
+			}
+			MoveOrder.StableSort([&Lines](int32 A, int32 B)
+			{
+				return Lines.CellLineStart[A + 1] - Lines.CellLineStart[A] > Lines.CellLineStart[B + 1] - Lines.CellLineStart[B];
+			});
+		}
+
+		int32 Negamax(FTicTacToeBoard& Board, int32 Depth, int32 Alpha, int32 Beta, int32 Ply, FTicTacToeSearchStats& OutStats)
+		{
+			OutStats.Nodes++;
+			PVLength[Ply] = Ply;
+
+			if ((OutStats.Nodes & 1023) == 0 && IsStopRequested())
+			{
+				bAborted = true;
+			}
+			if (bAborted)
+				return 0;
+
+			// The previous move ended the game, so the side to move has either lost or drawn
+			if (Board.IsGameOver())
+				return Board.Result == ETicTacToeResult::Draw ? 0 : -(WinScore - Ply);
+
+			if (Depth <= 0)
+				return EvaluateLeaf(Board);
+
+			for (int32 Cell : MoveOrder)
+			{
+				if (!Board.IsEmpty(Cell))
+					continue;
+
+				MakeMove(Board, Cell);
+				const int32 Score = -Negamax(Board, Depth - 1, -Beta, -Alpha, Ply + 1, OutStats);
+				UndoMove(Board, Cell);
+
+				if (Score > Alpha)
+				{
+					Alpha = Score;
+
+					// Extend the principal variation with the child's
+					PV[Ply][Ply] = Cell;
+					for (int32 Next = Ply + 1; Next < PVLength[Ply + 1]; Next++)
+					{
+						PV[Ply][Next] = PV[Ply + 1][Next];
+					}
+					PVLength[Ply] = PVLength[Ply + 1];
+
+					if (Alpha >= Beta)
+						break;
+				}
+			}
+			return Alpha;
+		}
+	};
+
+	class FMonteCarloEngine : public FTicTacToeEngine
+	{
+	public:
+		using FTicTacToeEngine::FTicTacToeEngine;
+
+		virtual int32 ChooseMove(const FTicTacToeBoard& Board, FRandomStream& Random, FTicTacToeSearchStats& OutStats) override
+		{
+			const int32 Side = Board.GetSideToMove();
+
+			// Never sample away a one move win
+			const int32 WinningCell = FindWinningCell(Board, Side);
+			if (WinningCell != INDEX_NONE)
+			{
+				OutStats.Nodes++;
+				return WinningCell;
+			}
+
+			const uint64 Empty = Board.GetEmptyMask();
+			const int32 PlayoutsPerMove = FMath::Max(1, Settings.Playouts / FMath::CountBits(Empty));
+
+			int32 BestCell = INDEX_NONE;
+			int32 BestScore = MIN_int32;
+			for (uint64 Moves = Empty; Moves; Moves &= Moves - 1)
+			{
+				const int32 Cell = FMath::CountTrailingZeros64(Moves);
+
+				// Wins count 2, draws 1, losses 0
+				int32 Score = 0;
+				for (int32 Playout = 0; Playout < PlayoutsPerMove && !IsStopRequested(); Playout++)
+				{
+					FTicTacToeBoard Work = Board;
+					Work.MakeMove(Cell);
+					while (!Work.IsGameOver())
+					{
+						Work.MakeMove(RandomCell(Work.GetEmptyMask(), Random));
+						OutStats.Nodes++;
+					}
+
+					if (Work.Result == ETicTacToeResult::Draw)
+						Score += 1;
+					else if ((Work.Result == ETicTacToeResult::Player1Win) == (Side == 0))
+						Score += 2;
+				}
+
+				if (Score > BestScore)
+				{
+					BestScore = Score;
+					BestCell = Cell;
+				}
+			}
+			return BestCell;
+		}
+	};
+
+	/** Scores within this of WinScore are proven results */
+	constexpr int32 WinThreshold = FTicTacToeEngine::WinScore - 100;
+
+	/** Win scores count plies from the root, the table stores them counted from the entry's position */
+	FORCEINLINE int32 ScoreToTable(int32 Score, int32 Ply)
+	{
+		return Score >= WinThreshold ? Score + Ply : (Score <= -WinThreshold ? Score - Ply : Score);
+	}
+
+	FORCEINLINE int32 ScoreFromTable(int32 Score, int32 Ply)
+	{
+		return Score >= WinThreshold ? Score - Ply : (Score <= -WinThreshold ? Score + Ply : Score);
+	}
+
+	/**
+	 * Lazy SMP: every thread runs its own iterative deepening alpha-beta from the root, helpers with
+	 * their own move order and alternate depths, and all of them share one lock-free transposition
+	 * table keyed by the canonical position, so each thread's results prune the others' trees.
+	 * The calling thread's search decides the move; helpers stop when it finishes.
+	 */
+	class FLazySMPEngine : public FTicTacToeEngine
+	{
+	public:
+		explicit FLazySMPEngine(const FTicTacToeEngineSettings& InSettings)
+			: FTicTacToeEngine(InSettings)
+			, Table(MakeUnique<FTicTacToeTranspositionTable>(TableBits))
+			, Symmetry(nullptr)
+			, KeySalt(0)
+			, bStopHelpers(false)
+		{
+		}
+
+		virtual int32 ChooseMove(const FTicTacToeBoard& Board, FRandomStream& Random, FTicTacToeSearchStats& OutStats) override
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			Symmetry = &FTicTacToeSymmetry::Get(Board.Size);
+			KeySalt = uint64(Board.Size) * 0x632BE59BD9B4E019ull ^ uint64(Board.WinLength) * 0x94D049BB133111EBull;
+			bStopHelpers = false;
+
+			// The calling thread keeps the plain centre-first order, helpers break its ties at random
+			const int32 NumThreads = FPlatformProcess::SupportsMultithreading() ? FMath::Clamp(Settings.Threads, 1, MaxThreads) : 1;
+			Threads.Reset();
+			for (int32 Index = 0; Index < NumThreads; Index++)
+			{
+				Threads.Add(MakeUnique<FSearchThread>(*this, Board, Index, Index == 0 ? 0 : Random.GetUnsignedInt()));
+			}
+
+			const int32 MaxDepth = FMath::Min(Settings.MaxDepth, FMath::CountBits(Board.GetEmptyMask()));
+
+			// Helpers run on threads of their own, as this search may itself be a pool task
+			for (int32 Index = 1; Index < NumThreads; Index++)
+			{
+				if (HelperThreads.Num() < Index)
+				{
+					HelperThreads.Add(MakeUnique<FHelperThread>(Index));
+				}
+				HelperThreads[Index - 1]->Start(Threads[Index].Get(), Board, MaxDepth);
+			}
+
+			FSearchThread& Main = *Threads[0];
+			FTicTacToeBoard Work = Board;
+			int32 BestCell = FMath::CountTrailingZeros64(Board.GetEmptyMask());
+			for (int32 Depth = 1; Depth <= MaxDepth; Depth++)
+			{
+				int32 Cell = INDEX_NONE;
+				const int32 Score = Main.Negamax(Work, Depth, -WinScore - 1, WinScore + 1, 0, &Cell);
+
+				// An unfinished iteration has no trustworthy move, the last completed one stands
+				if (Main.bAborted)
+					break;
+
+				BestCell = Cell;
+
+				if (Control)
+				{
+					FTicTacToeSearchProgress Progress;
+					GetPrincipalVariation(Board, BestCell, Depth, Progress.PrincipalVariation);
+					Progress.Depth = Depth;
+					Progress.Nodes = GetNodes();
+					Progress.Seconds = FPlatformTime::Seconds() - StartTime;
+					Progress.Score = Score;
+					Progress.BestMove = BestCell;
+					Control->ReportProgress(Progress);
+				}
+
+				if (FMath::Abs(Score) >= WinThreshold)
+					break;
+			}
+
+			bStopHelpers = true;
+			for (int32 Index = 1; Index < NumThreads; Index++)
+			{
+				HelperThreads[Index - 1]->Wait();
+			}
+
+			for (const TUniquePtr<FSearchThread>& Thread : Threads)
+			{
+				OutStats.Nodes += Thread->Nodes;
+			}
+			return BestCell;
+		}
+
+	private:
+
+		struct FSearchThread
+		{
+			FSearchThread(FLazySMPEngine& InEngine, const FTicTacToeBoard& Board, int32 InIndex, uint32 Seed)
+				: Engine(InEngine)
+				, Index(InIndex)
+				, Nodes(0)
+				, PublishedNodes(0)
+				, bAborted(false)
+			{
+				// Cells with more lines through them first, ties broken by the seed
+				const FTicTacToeLineTable& Lines = Board.GetLines();
+				FRandomStream Random(Seed);
+				TArray<TPair<int32, int32>, TInlineAllocator<64>> Keys;
+				for (int32 Cell = 0; Cell < Board.NumCells; Cell++)
+				{
+					const int32 NumLines = Lines.CellLineStart[Cell + 1] - Lines.CellLineStart[Cell];
+					Keys.Emplace(-NumLines * 256 - (Index == 0 ? 0 : Random.RandHelper(256)), Cell);
+				}
+				Keys.StableSort([](const TPair<int32, int32>& A, const TPair<int32, int32>& B)
+				{
+					return A.Key < B.Key;
+				});
+				for (const TPair<int32, int32>& Key : Keys)
+				{
+					MoveOrder.Add(Key.Value);
+				}
+			}
+
+			/** Deepens until the calling thread is done, odd helpers one ply ahead of even ones */
+			void RunHelper(const FTicTacToeBoard& Board, int32 MaxDepth)
+			{
+				FTicTacToeBoard Work = Board;
+				for (int32 Depth = 1 + (Index & 1); Depth <= MaxDepth && !bAborted; Depth++)
+				{
+					Negamax(Work, Depth, -WinScore - 1, WinScore + 1, 0);
+				}
+			}
+
+			int32 Negamax(FTicTacToeBoard& Board, int32 Depth, int32 Alpha, int32 Beta, int32 Ply, int32* OutBestCell = nullptr)
+			{
+				Nodes++;
+				if ((Nodes & 1023) == 0)
+				{
+					PublishedNodes.Store(Nodes, EMemoryOrder::Relaxed);
+					if ((Index > 0 && Engine.bStopHelpers.Load(EMemoryOrder::Relaxed)) || Engine.IsStopRequested())
+					{
+						bAborted = true;
+					}
+				}
+				if (bAborted)
+					return 0;
+
+				// The previous move ended the game, so the side to move has either lost or drawn
+				if (Board.IsGameOver())
+					return Board.Result == ETicTacToeResult::Draw ? 0 : -(WinScore - Ply);
+
+				if (Depth <= 0)
+					return Evaluate(Board);
+
+				// Every orientation of a position shares an entry, with moves stored in the canonical orientation
+				const FTicTacToeCanonicalPosition Canonical = Engine.Symmetry->Canonicalize(Board);
+				const uint64 Key = Canonical.GetKey() ^ Engine.KeySalt;
+
+				int32 HashCell = INDEX_NONE;
+				FTicTacToeTableEntry Entry;
+				if (Engine.Table->Probe(Key, Entry))
+				{
+					if (Entry.BestMove != INDEX_NONE)
+					{
+						HashCell = Engine.Symmetry->TransformCell(Entry.BestMove, FTicTacToeSymmetry::GetInverse(Canonical.Transform));
+					}
+
+					// The root is always searched so it has a move to return
+					if (Ply > 0 && Entry.Depth >= Depth)
+					{
+						const int32 Score = ScoreFromTable(Entry.Score, Ply);
+						if (Entry.Bound == ETicTacToeBound::Exact
+							|| (Entry.Bound == ETicTacToeBound::Lower && Score >= Beta)
+							|| (Entry.Bound == ETicTacToeBound::Upper && Score <= Alpha))
+							return Score;
+					}
+				}
+
+				const int32 OriginalAlpha = Alpha;
+				int32 BestScore = -WinScore - 1;
+				int32 BestCell = INDEX_NONE;
+				for (int32 OrderIndex = -1; OrderIndex < MoveOrder.Num(); OrderIndex++)
+				{
+					// The table's move first, then this thread's order
+					const int32 Cell = OrderIndex < 0 ? HashCell : MoveOrder[OrderIndex];
+					if (Cell == INDEX_NONE || (OrderIndex >= 0 && Cell == HashCell) || !Board.IsEmpty(Cell))
+						continue;
+
+					Board.MakeMove(Cell);
+					const int32 Score = -Negamax(Board, Depth - 1, -Beta, -Alpha, Ply + 1);
+					Board.UndoMove(Cell);
+
+					if (bAborted)
+						return 0;
+
+					if (Score > BestScore)
+					{
+						BestScore = Score;
+						BestCell = Cell;
+						if (Score > Alpha)
+						{
+							Alpha = Score;
+							if (Alpha >= Beta)
+								break;
+						}
+					}
+				}
+
+				Entry.Score = ScoreToTable(BestScore, Ply);
+				Entry.Depth = Depth;
+				Entry.Bound = BestScore <= OriginalAlpha ? ETicTacToeBound::Upper : (BestScore >= Beta ? ETicTacToeBound::Lower : ETicTacToeBound::Exact);
+				Entry.BestMove = Engine.Symmetry->TransformCell(BestCell, Canonical.Transform);
+				Engine.Table->Store(Key, Entry);
+
+				if (OutBestCell)
+				{
+					*OutBestCell = BestCell;
+				}
+				return BestScore;
+			}
+
+			FLazySMPEngine& Engine;
+
+			/** 0 for the calling thread */
+			int32 Index;
+
+			TArray<int32, TInlineAllocator<64>> MoveOrder;
+
+			int64 Nodes;
+
+			/** Nodes as of the last stop check, for progress reports from the calling thread */
+			TAtomic<int64> PublishedNodes;
+
+			bool bAborted;
+		};
+
+		/** Runs one helper per search, parked on an event in between so moves do not pay for new threads */
+		class FHelperThread : public FRunnable
+		{
+		public:
+			explicit FHelperThread(int32 Index)
+				: Search(nullptr)
+				, MaxDepth(0)
+				, bExit(false)
+			{
+				WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+				DoneEvent = FPlatformProcess::GetSynchEventFromPool(false);
+				Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("TicTacToeLazySMP%d"), Index));
+			}
+
+			virtual ~FHelperThread()
+			{
+				Stop();
+				Thread->WaitForCompletion();
+				delete Thread;
+				FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+				FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+			}
+
+			void Start(FSearchThread* InSearch, const FTicTacToeBoard& InBoard, int32 InMaxDepth)
+			{
+				Search = InSearch;
+				Board = InBoard;
+				MaxDepth = InMaxDepth;
+				WorkEvent->Trigger();
+			}
+
+			/** Blocks until the helper started last has stopped */
+			void Wait()
+			{
+				DoneEvent->Wait();
+			}
+
+			// Begin FRunnable interface
+			virtual uint32 Run() override
+			{
+				for (;;)
+				{
+					WorkEvent->Wait();
+					if (bExit)
+						break;
+
+					Search->RunHelper(Board, MaxDepth);
+					DoneEvent->Trigger();
+				}
+				return 0;
+			}
+
+			virtual void Stop() override
+			{
+				bExit = true;
+				WorkEvent->Trigger();
+			}
+			// End FRunnable interface
+
+		private:
+			FRunnableThread* Thread;
+			FEvent* WorkEvent;
+			FEvent* DoneEvent;
+
+			FSearchThread* Search;
+			FTicTacToeBoard Board;
+			int32 MaxDepth;
+
+			TAtomic<bool> bExit;
+		};
+
+		/** Nodes searched so far by all threads */
+		int64 GetNodes() const
+		{
+			int64 Total = Threads[0]->Nodes;
+			for (int32 Index = 1; Index < Threads.Num(); Index++)
+			{
+				Total += Threads[Index]->PublishedNodes.Load(EMemoryOrder::Relaxed);
+			}
+			return Total;
+		}
+
+		/** Follows the table's best moves from the root, starting with FirstCell */
+		void GetPrincipalVariation(const FTicTacToeBoard& Board, int32 FirstCell, int32 MaxLength, TArray<int32>& OutCells) const
+		{
+			FTicTacToeBoard Work = Board;
+			int32 Cell = FirstCell;
+			while (Cell != INDEX_NONE && OutCells.Num() < MaxLength && Work.IsEmpty(Cell) && !Work.IsGameOver())
+			{
+				OutCells.Add(Cell);
+				Work.MakeMove(Cell);
+
+				const FTicTacToeCanonicalPosition Canonical = Symmetry->Canonicalize(Work);
+				FTicTacToeTableEntry Entry;
+				Cell = INDEX_NONE;
+				if (!Work.IsGameOver() && Table->Probe(Canonical.GetKey() ^ KeySalt, Entry) && Entry.BestMove != INDEX_NONE)
+				{
+					Cell = Symmetry->TransformCell(Entry.BestMove, FTicTacToeSymmetry::GetInverse(Canonical.Transform));
+				}
+			}
+		}
+
+		/** 16 MB of table, kept between moves */
+		static constexpr int32 TableBits = 20;
+
+		static constexpr int32 MaxThreads = 64;
+
+		TUniquePtr<FTicTacToeTranspositionTable> Table;
+
+		const FTicTacToeSymmetry* Symmetry;
+
+		/** Tells apart positions of different board shapes that have the same marks */
+		uint64 KeySalt;
+
+		/** Raised when the calling thread's search is over */
+		TAtomic<bool> bStopHelpers;
+
+		TArray<TUniquePtr<FSearchThread>> Threads;
+
+		/** Started as searches first need them; declared last so they stop before anything they use goes */
+		TArray<TUniquePtr<FHelperThread>> HelperThreads;
+	};
+}
+
+bool FTicTacToeSearchControl::ShouldStop() const
+{
+	return (StopFlag && StopFlag->Load(EMemoryOrder::Relaxed)) || (Deadline > 0.0 && FPlatformTime::Seconds() >= Deadline);
+}
+
+void FTicTacToeSearchControl::ReportProgress(const FTicTacToeSearchProgress& Progress) const
+{
+	if (OnProgress)
+	{
+		OnProgress(Progress);
+	}
+}
+
+bool FTicTacToeEngineSettings::Parse(const FString& Spec, FTicTacToeEngineSettings& OutSettings)
+{
+	FString TypeName = Spec;
+	FString Param;
+	Spec.Split(TEXT(":"), &TypeName, &Param);
+
+	OutSettings = FTicTacToeEngineSettings();
+	OutSettings.Name = Spec;
+
+	if (TypeName == TEXT("Random"))
+	{
+		OutSettings.Type = ETicTacToeEngineType::Random;
+	}
+	else if (TypeName == TEXT("Tactical"))
+	{
+		OutSettings.Type = ETicTacToeEngineType::Tactical;
+	}
+	else if (TypeName == TEXT("AlphaBeta"))
+	{
+		OutSettings.Type = ETicTacToeEngineType::AlphaBeta;
+		if (!Param.IsEmpty())
+			OutSettings.MaxDepth = FMath::Max(1, FCString::Atoi(*Param));
+	}
+	else if (TypeName == TEXT("MonteCarlo"))
+	{
+		OutSettings.Type = ETicTacToeEngineType::MonteCarlo;
+		if (!Param.IsEmpty())
+			OutSettings.Playouts = FMath::Max(1, FCString::Atoi(*Param));
+	}
+	else if (TypeName == TEXT("NTuple"))
+	{
+		OutSettings.Type = ETicTacToeEngineType::NTuple;
+		if (!Param.IsEmpty())
+			OutSettings.MaxDepth = FMath::Max(1, FCString::Atoi(*Param));
+	}
+	else if (TypeName == TEXT("LazySMP"))
+	{
+		OutSettings.Type = ETicTacToeEngineType::LazySMP;
+
+		FString Depth = Param;
+		FString Threads;
+		Param.Split(TEXT(":"), &Depth, &Threads);
+		if (!Depth.IsEmpty())
+			OutSettings.MaxDepth = FMath::Max(1, FCString::Atoi(*Depth));
+		if (!Threads.IsEmpty())
+			OutSettings.Threads = FMath::Max(1, FCString::Atoi(*Threads));
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+TUniquePtr<FTicTacToeEngine> FTicTacToeEngine::Create(const FTicTacToeEngineSettings& Settings)
+{
+	switch (Settings.Type)
+	{
+	case ETicTacToeEngineType::Tactical:
+		return MakeUnique<FTacticalEngine>(Settings);
+	case ETicTacToeEngineType::AlphaBeta:
+	case ETicTacToeEngineType::NTuple:
+		return MakeUnique<FAlphaBetaEngine>(Settings);
+	case ETicTacToeEngineType::MonteCarlo:
+		return MakeUnique<FMonteCarloEngine>(Settings);
+	case ETicTacToeEngineType::LazySMP:
+		return MakeUnique<FLazySMPEngine>(Settings);
+	default:
+		return MakeUnique<FRandomEngine>(Settings);
+	}
+}
+
+int32 FTicTacToeEngine::Evaluate(const FTicTacToeBoard& Board)
+{
+	// Open lines are worth 4^marks, lines holding both players' marks are dead
+	const int32 Side = Board.GetSideToMove();
+	const uint64 Own = Board.Marks[Side];
+	const uint64 Other = Board.Marks[Side ^ 1];
+
+	int32 Score = 0;
+	for (uint64 Line : Board.GetLines().Lines)
+	{
+		const uint64 OwnInLine = Own & Line;
+		const uint64 OtherInLine = Other & Line;
+		if (OwnInLine && !OtherInLine)
+		{
+			Score += 1 << (2 * FMath::CountBits(OwnInLine));
+		}
+		else if (OtherInLine && !OwnInLine)
+		{
+			Score -= 1 << (2 * FMath::CountBits(OtherInLine));
+		}
+	}
+	return Score;
+}
+
+int32 FTicTacToeEngine::RandomCell(uint64 Mask, FRandomStream& Random)
+{
+	for (int32 Skip = Random.RandHelper(FMath::CountBits(Mask)); Skip > 0; Skip--)
+	{
+		Mask &= Mask - 1;
+	}
+	return FMath::CountTrailingZeros64(Mask);
+}
+
+int32 FTicTacToeEngine::FindWinningCell(const FTicTacToeBoard& Board, int32 Player)
+{
+	// A line is one move from completion when it has a single empty cell and no opposing mark
+	const uint64 Own = Board.Marks[Player];
+	const uint64 Empty = Board.GetEmptyMask();
+	for (uint64 Line : Board.GetLines().Lines)
+	{
+		const uint64 Missing = Line & ~Own;
+		if (Missing && (Missing & (Missing - 1)) == 0 && (Missing & Empty))
+		{
+			return FMath::CountTrailingZeros64(Missing);
+		}
+	}
+	return INDEX_NONE;
+}
@@ -0,0 +1,147 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+#include "TicTacToeBoard.h"
+
+/** Move selection policies available to the AI */
+enum class ETicTacToeEngineType : uint8
+{
+	/** Uniformly random legal move */
+	Random,
+	/** Win if possible, otherwise block, otherwise random */
+	Tactical,
+	/** Depth limited alpha-beta over a line count evaluation */
+	AlphaBeta,
+	/** Flat Monte Carlo playouts per candidate move */
+	MonteCarlo,
+	/** Alpha-beta on several threads sharing one transposition table */
+	LazySMP,
+	/** Alpha-beta evaluating leaves with the board's trained n-tuple network, if it has one */
+	NTuple
+};
+
+/** Configuration of one AI player */
+struct TICTACTOE_API FTicTacToeEngineSettings
+{
+	FTicTacToeEngineSettings()
+		: Type(ETicTacToeEngineType::Random)
+		, MaxDepth(4)
+		, Playouts(1000)
+		, Threads(4)
+	{
+	}
+
+	/** Display name used in reports */
+	FString Name;
+
+	ETicTacToeEngineType Type;
+
+	/** Search depth in plies for AlphaBeta, LazySMP and NTuple */
+	int32 MaxDepth;
+
+	/** Total playouts per move for MonteCarlo */
+	int32 Playouts;
+
+	/** Searching threads for LazySMP, including the calling thread */
+	int32 Threads;
+
+	/** Parses "Type[:Param[:Threads]]", e.g. "AlphaBeta:6", "MonteCarlo:2000" or "LazySMP:8:4". Param is depth or playouts. */
+	static bool Parse(const FString& Spec, FTicTacToeEngineSettings& OutSettings);
+};
+
+/** Work counters for one move decision */
+struct FTicTacToeSearchStats
+{
+	FTicTacToeSearchStats() : Nodes(0) { }
+
+	/** Positions visited, including playout steps */
+	int64 Nodes;
+};
+
+/** Snapshot of a search in progress, reported after each completed iteration */
+struct FTicTacToeSearchProgress
+{
+	FTicTacToeSearchProgress() : Depth(0), Nodes(0), Seconds(0.0), Score(0), BestMove(INDEX_NONE) { }
+
+	/** Completed iteration depth, or principal variation length for tree search */
+	int32 Depth;
+
+	/** Positions visited so far */
+	int64 Nodes;
+
+	/** Time since the search started */
+	double Seconds;
+
+	/** Value of BestMove for the side to move, in evaluation units or +-1000 for a tree search win rate */
+	int32 Score;
+
+	/** Best move so far in the searcher's own move encoding */
+	int32 BestMove;
+
+	/** Expected line of play starting with BestMove */
+	TArray<int32> PrincipalVariation;
+};
+
+/** Limits and reporting for one search, shared with the thread running it */
+struct TICTACTOE_API FTicTacToeSearchControl
+{
+	FTicTacToeSearchControl() : Deadline(0.0), StopFlag(nullptr), ProgressInterval(0.1) { }
+
+	/** FPlatformTime::Seconds() by which a move must be returned, 0 for no limit */
+	double Deadline;
+
+	/** Flag another thread may raise to cut the search short */
+	const TAtomic<bool>* StopFlag;
+
+	/** Called on the searching thread with each progress report */
+	TFunction<void(const FTicTacToeSearchProgress&)> OnProgress;
+
+	/** Seconds between reports from searches without iterations */
+	double ProgressInterval;
+
+	/** Has the deadline passed or a stop been requested? Searchers poll this every few hundred nodes. */
+	bool ShouldStop() const;
+
+	void ReportProgress(const FTicTacToeSearchProgress& Progress) const;
+};
+
+/** An AI player that picks a move for the side to move */
+class TICTACTOE_API FTicTacToeEngine
+{
+public:
+	explicit FTicTacToeEngine(const FTicTacToeEngineSettings& InSettings) : Settings(InSettings), Control(nullptr) { }
+	virtual ~FTicTacToeEngine() { }
+
+	/** Returns the chosen cell. Board must not be game over. All randomness comes from Random. */
+	virtual int32 ChooseMove(const FTicTacToeBoard& Board, FRandomStream& Random, FTicTacToeSearchStats& OutStats) = 0;
+
+	FORCEINLINE const FTicTacToeEngineSettings& GetSettings() const { return Settings; }
+
+	/** Deadline, stop flag and progress reporting for later searches. A stopped search returns its best guess. */
+	FORCEINLINE void SetSearchControl(const FTicTacToeSearchControl* InControl) { Control = InControl; }
+
+	/** Creates the engine described by Settings */
+	static TUniquePtr<FTicTacToeEngine> Create(const FTicTacToeEngineSettings& Settings);
+
+	/** Static evaluation from the side to move's point of view */
+	static int32 Evaluate(const FTicTacToeBoard& Board);
+
+	/** Picks a uniformly random set bit of Mask, which must be non-zero */
+	static int32 RandomCell(uint64 Mask, FRandomStream& Random);
+
+	/** Returns a cell completing a line for Player, or INDEX_NONE */
+	static int32 FindWinningCell(const FTicTacToeBoard& Board, int32 Player);
+
+	/** Score of a won position, reduced by ply so faster wins are preferred */
+	static constexpr int32 WinScore = 1000000;
+
+protected:
+	FORCEINLINE bool IsStopRequested() const { return Control && Control->ShouldStop(); }
+
+	FTicTacToeEngineSettings Settings;
+
+	const FTicTacToeSearchControl* Control;
+};
@@ -0,0 +1,61 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeAIPlayer.h"
+
+FTicTacToeAIPlayer::FTicTacToeAIPlayer(const FTicTacToeAIPlayerSettings& InSettings, int32 Seed)
+	: Settings(InSettings)
+	, Control(nullptr)
+	, Random(Seed)
+{
+}
+
+int32 FTicTacToeAIPlayer::ChooseMove(const FTicTacToePosition& Position, FTicTacToeSearchStats& OutStats)
+{
+	// Each mode's AI is made on its first move, as most players only ever see one mode
+	switch (Position.Mode)
+	{
+	case ETicTacToeGridMode::Ultimate:
+		if (!UltimateAI.IsValid())
+		{
+			UltimateAI = MakeUnique<FTicTacToeUltimateAI>(Settings.UltimateIterations);
+			UltimateAI->Control = Control;
+		}
+		return FTicTacToeUltimateBoard::GridIndexFromMove(UltimateAI->ChooseMove(Position.Ultimate, Random, OutStats));
+	case ETicTacToeGridMode::Qubic:
+		if (!QubicAI.IsValid())
+		{
+			QubicAI = MakeUnique<FTicTacToeQubicAI>(Settings.QubicMaxDepth, Settings.QubicTimeLimit);
+			QubicAI->Control = Control;
+		}
+		return QubicAI->ChooseMove(Position.Qubic, Random, OutStats);
+	default:
+		if (!ClassicAI.IsValid())
+		{
+			FTicTacToeEngineSettings ClassicSettings;
+			// NTuple is plain alpha-beta on boards without a trained network
+			ClassicSettings.Type = Settings.ClassicThreads > 1 ? ETicTacToeEngineType::LazySMP : ETicTacToeEngineType::NTuple;
+			ClassicSettings.MaxDepth = Settings.ClassicDepth;
+			ClassicSettings.Threads = Settings.ClassicThreads;
+			ClassicAI = FTicTacToeEngine::Create(ClassicSettings);
+			ClassicAI->SetSearchControl(Control);
+		}
+		return ClassicAI->ChooseMove(Position.Classic, Random, OutStats);
+	}
+}
+
+void FTicTacToeAIPlayer::SetSearchControl(const FTicTacToeSearchControl* InControl)
+{
+	Control = InControl;
+	if (ClassicAI.IsValid())
+	{
+		ClassicAI->SetSearchControl(Control);
+	}
+	if (UltimateAI.IsValid())
+	{
+		UltimateAI->Control = Control;
+	}
+	if (QubicAI.IsValid())
+	{
+		QubicAI->Control = Control;
+	}
+}
@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToePosition.h"
+
+/** Strength settings for the AI of each grid mode */
+struct TICTACTOE_API FTicTacToeAIPlayerSettings
+{
+	FTicTacToeAIPlayerSettings()
+		: ClassicDepth(9)
+		, ClassicThreads(1)
+		, UltimateIterations(20000)
+		, QubicMaxDepth(8)
+		, QubicTimeLimit(0.5f)
+	{
+	}
+
+	/** Search depth of the Classic alpha-beta */
+	int32 ClassicDepth;
+
+	/** Threads of the Classic alpha-beta, above one runs a Lazy SMP search */
+	int32 ClassicThreads;
+
+	/** Playouts per move of the Ultimate tree search */
+	int32 UltimateIterations;
+
+	/** Deepest iteration of the Qubic alpha-beta */
+	int32 QubicMaxDepth;
+
+	/** Seconds per move of the Qubic alpha-beta, 0 for none */
+	float QubicTimeLimit;
+
+	bool operator==(const FTicTacToeAIPlayerSettings& Other) const
+	{
+		return ClassicDepth == Other.ClassicDepth && ClassicThreads == Other.ClassicThreads && UltimateIterations == Other.UltimateIterations
+			&& QubicMaxDepth == Other.QubicMaxDepth && QubicTimeLimit == Other.QubicTimeLimit;
+	}
+
+	bool operator!=(const FTicTacToeAIPlayerSettings& Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+/**
+ * Picks moves for any grid mode by handing the position to that mode's AI, made the first time
+ * the mode comes up. Not thread safe, each thread that searches needs its own instance.
+ */
+class TICTACTOE_API FTicTacToeAIPlayer
+{
+public:
+	explicit FTicTacToeAIPlayer(const FTicTacToeAIPlayerSettings& InSettings, int32 Seed = 0);
+
+	/** Returns the chosen block index. Position must not be game over. */
+	int32 ChooseMove(const FTicTacToePosition& Position, FTicTacToeSearchStats& OutStats);
+
+	/** Deadline, stop flag and progress reporting for later searches, moves in progress reports are in the mode AI's encoding */
+	void SetSearchControl(const FTicTacToeSearchControl* InControl);
+
+private:
+
+	FTicTacToeAIPlayerSettings Settings;
+	const FTicTacToeSearchControl* Control;
+
+	TUniquePtr<FTicTacToeEngine> ClassicAI;
+	TUniquePtr<FTicTacToeUltimateAI> UltimateAI;
+	TUniquePtr<FTicTacToeQubicAI> QubicAI;
+	FRandomStream Random;
+};
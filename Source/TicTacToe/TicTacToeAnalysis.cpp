@@ -0,0 +1,311 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeAnalysis.h"
+#include "TicTacToeSymmetry.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	/** Proven results sit within this of WinScore */
+	constexpr int32 WinThreshold = FTicTacToeEngine::WinScore - 100;
+
+	/** Evaluation that maps to a value of one half, per mode */
+	float GetHalfValueScore(ETicTacToeGridMode Mode)
+	{
+		switch (Mode)
+		{
+		case ETicTacToeGridMode::Ultimate:
+			return 500.f;
+		case ETicTacToeGridMode::Qubic:
+			return 40.f;
+		default:
+			return 64.f;
+		}
+	}
+
+	/** Does Reply end the game in a win for the side playing it? */
+	bool RepliesWithWin(const FTicTacToePosition& Position, int32 Reply)
+	{
+		if (!Position.IsLegal(Reply))
+			return false;
+
+		FTicTacToePosition After = Position;
+		After.MakeMove(Reply);
+		return After.IsGameOver() && After.GetResult() != ETicTacToeResult::Draw;
+	}
+}
+
+FTicTacToeAnalysis::FTicTacToeAnalysis(const FTicTacToePosition& InPosition, const FTicTacToeAIPlayerSettings& InSettings, double InTimePerMove)
+	: Position(InPosition)
+	, Settings(InSettings)
+	, TimePerMove(InTimePerMove)
+	, NumMoves(0)
+	, bCancelled(false)
+	, NumPendingSearches(0)
+{
+	NumMoves = Position.GenerateMoves(Moves);
+	for (int32 MoveIndex = 0; MoveIndex < NumMoves; MoveIndex++)
+	{
+		SearchedMove[MoveIndex] = MoveIndex;
+	}
+
+	if (Position.Mode == ETicTacToeGridMode::Classic)
+	{
+		// Moves swapped by a transform that leaves the board unchanged are worth the same
+		const FTicTacToeSymmetry& Symmetry = FTicTacToeSymmetry::Get(Position.Classic.Size);
+		const uint32 Stabilizer = Symmetry.GetStabilizer(Position.Classic);
+		for (int32 MoveIndex = 0; MoveIndex < NumMoves; MoveIndex++)
+		{
+			for (int32 Transform = 1; Transform < FTicTacToeSymmetry::NumTransforms; Transform++)
+			{
+				if (!((Stabilizer >> Transform) & 1))
+					continue;
+
+				// Earlier moves already point at the first move of their orbit
+				const int32 Image = Symmetry.TransformCell(Moves[MoveIndex], ETicTacToeSymmetry(Transform));
+				for (int32 Other = 0; Other < SearchedMove[MoveIndex]; Other++)
+				{
+					if (Moves[Other] == Image)
+					{
+						SearchedMove[MoveIndex] = SearchedMove[Other];
+						break;
+					}
+				}
+			}
+		}
+	}
+}
+
+void FTicTacToeAnalysis::Start()
+{
+	// Each task holds a reference, so an analysis outlives a cache that drops it
+	TSharedRef<FTicTacToeAnalysis, ESPMode::ThreadSafe> Self = AsShared();
+	{
+		FScopeLock Lock(&Mutex);
+		for (int32 MoveIndex = 0; MoveIndex < NumMoves; MoveIndex++)
+		{
+			NumPendingSearches += SearchedMove[MoveIndex] == MoveIndex;
+		}
+	}
+
+	for (int32 MoveIndex = 0; MoveIndex < NumMoves; MoveIndex++)
+	{
+		if (SearchedMove[MoveIndex] != MoveIndex)
+			continue;
+
+		Async(EAsyncExecution::ThreadPool, [Self, MoveIndex]()
+		{
+			Self->AnalyseMove(MoveIndex);
+
+			// Cached analyses are kept for their results, not their tables
+			FScopeLock Lock(&Self->Mutex);
+			if (--Self->NumPendingSearches == 0)
+			{
+				Self->IdleAIPlayers.Reset();
+			}
+		});
+	}
+}
+
+void FTicTacToeAnalysis::Cancel()
+{
+	bCancelled = true;
+
+	FScopeLock Lock(&Mutex);
+	for (const TSharedPtr<FTicTacToeAnytimeSearch, ESPMode::ThreadSafe>& Search : RunningSearches)
+	{
+		Search->Cancel();
+	}
+}
+
+bool FTicTacToeAnalysis::IsComplete() const
+{
+	FScopeLock Lock(&Mutex);
+	return Results.Num() == NumMoves;
+}
+
+int32 FTicTacToeAnalysis::CopyResults(int32 StartIndex, TArray<FTicTacToeMoveAnalysis>& OutResults) const
+{
+	FScopeLock Lock(&Mutex);
+	for (int32 Index = StartIndex; Index < Results.Num(); Index++)
+	{
+		OutResults.Add(Results[Index]);
+	}
+	return Results.Num();
+}
+
+void FTicTacToeAnalysis::AnalyseMove(int32 MoveIndex)
+{
+	if (bCancelled)
+		return;
+
+	const int32 Move = Moves[MoveIndex];
+	FTicTacToePosition Child = Position;
+	Child.MakeMove(Move);
+
+	FTicTacToeSearchProgress ReplyProgress;
+	if (!Child.IsGameOver())
+	{
+		TUniquePtr<FTicTacToeAIPlayer> AIPlayer;
+		{
+			FScopeLock Lock(&Mutex);
+			if (IdleAIPlayers.Num() > 0)
+			{
+				AIPlayer = IdleAIPlayers.Pop(false);
+			}
+		}
+		if (!AIPlayer.IsValid())
+		{
+			AIPlayer = MakeUnique<FTicTacToeAIPlayer>(FTicTacToeAnytimeSearch::GetSearchSettings(Settings), int32(Child.GetKey()));
+		}
+
+		// The budget starts when the task does, not when it was queued
+		TSharedRef<FTicTacToeAnytimeSearch, ESPMode::ThreadSafe> Search = MakeShared<FTicTacToeAnytimeSearch, ESPMode::ThreadSafe>(
+			Child, *AIPlayer, TimePerMove);
+		{
+			FScopeLock Lock(&Mutex);
+			if (bCancelled)
+			{
+				IdleAIPlayers.Add(MoveTemp(AIPlayer));
+				return;
+			}
+			RunningSearches.Add(Search);
+		}
+
+		Search->Run();
+		ReplyProgress = Search->GetProgress();
+
+		FScopeLock Lock(&Mutex);
+		RunningSearches.Remove(Search);
+		IdleAIPlayers.Add(MoveTemp(AIPlayer));
+	}
+
+	// A cancelled search stopped early, its estimate is not worth keeping
+	if (bCancelled)
+		return;
+
+	FTicTacToeMoveAnalysis Result = MakeResult(Move, Child, ReplyProgress);
+
+	FScopeLock Lock(&Mutex);
+	for (int32 Index = 0; Index < NumMoves; Index++)
+	{
+		if (SearchedMove[Index] == MoveIndex)
+		{
+			Result.BlockIndex = Moves[Index];
+			Results.Add(Result);
+		}
+	}
+}
+
+FTicTacToeMoveAnalysis FTicTacToeAnalysis::MakeResult(int32 Move, const FTicTacToePosition& Child, const FTicTacToeSearchProgress& ReplyProgress) const
+{
+	FTicTacToeMoveAnalysis Result;
+	Result.BlockIndex = Move;
+	Result.Depth = ReplyProgress.Depth + 1;
+
+	if (Child.IsGameOver())
+	{
+		Result.Verdict = Child.GetResult() == ETicTacToeResult::Draw ? ETicTacToeMoveVerdict::Draw : ETicTacToeMoveVerdict::Win;
+	}
+	else if (RepliesWithWin(Child, ReplyProgress.BestMove))
+	{
+		// Searches take an immediate win without reporting a score
+		Result.Verdict = ETicTacToeMoveVerdict::Loss;
+	}
+	else if (ReplyProgress.Score <= -WinThreshold)
+	{
+		Result.Verdict = ETicTacToeMoveVerdict::Win;
+	}
+	else if (ReplyProgress.Score >= WinThreshold)
+	{
+		Result.Verdict = ETicTacToeMoveVerdict::Loss;
+	}
+	else if (Position.Mode == ETicTacToeGridMode::Classic && ReplyProgress.Depth >= FMath::CountBits(Child.Classic.GetEmptyMask()))
+	{
+		// Searched to the end of the game without a forced win for either side
+		Result.Verdict = ETicTacToeMoveVerdict::Draw;
+	}
+
+	switch (Result.Verdict)
+	{
+	case ETicTacToeMoveVerdict::Win:
+		Result.Value = 1.f;
+		break;
+	case ETicTacToeMoveVerdict::Loss:
+		Result.Value = -1.f;
+		break;
+	case ETicTacToeMoveVerdict::Draw:
+		Result.Value = 0.f;
+		break;
+	default:
+	{
+		// Squash the reply's score into (-1, 1) from the mover's side
+		const float Score = float(-ReplyProgress.Score);
+		Result.Value = Score / (FMath::Abs(Score) + GetHalfValueScore(Position.Mode));
+		break;
+	}
+	}
+	return Result;
+}
+
+FTicTacToeAnalysisCache::FTicTacToeAnalysisCache()
+	: TimePerMove(0.0)
+{
+}
+
+TSharedRef<FTicTacToeAnalysis, ESPMode::ThreadSafe> FTicTacToeAnalysisCache::FindOrStart(const FTicTacToePosition& Position, const FTicTacToeAIPlayerSettings& InSettings, double InTimePerMove)
+{
+	// Analyses made with other settings would show values the grid no longer asks for
+	if (InSettings != Settings || InTimePerMove != TimePerMove)
+	{
+		Reset();
+		Settings = InSettings;
+		TimePerMove = InTimePerMove;
+	}
+
+	const uint64 Key = Position.GetKey();
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
+	{
+		if (Entries[Index].Key == Key)
+		{
+			// Move to the most recently used end
+			TPair<uint64, TSharedRef<FTicTacToeAnalysis, ESPMode::ThreadSafe>> Entry = Entries[Index];
+			Entries.RemoveAt(Index);
+			Entries.Add(Entry);
+			return Entry.Value;
+		}
+	}
+
+	if (Entries.Num() >= MaxEntries)
+	{
+		Entries[0].Value->Cancel();
+		Entries.RemoveAt(0);
+	}
+
+	TSharedRef<FTicTacToeAnalysis, ESPMode::ThreadSafe> Analysis = MakeShared<FTicTacToeAnalysis, ESPMode::ThreadSafe>(Position, Settings, TimePerMove);
+	Analysis->Start();
+	Entries.Emplace(Key, Analysis);
+	return Analysis;
+}
+
+void FTicTacToeAnalysisCache::Release(const TSharedRef<FTicTacToeAnalysis, ESPMode::ThreadSafe>& Analysis)
+{
+	if (Analysis->IsComplete())
+		return;
+
+	Analysis->Cancel();
+	Entries.RemoveAll([&Analysis](const TPair<uint64, TSharedRef<FTicTacToeAnalysis, ESPMode::ThreadSafe>>& Entry)
+	{
+		return Entry.Value == Analysis;
+	});
+}
+
+void FTicTacToeAnalysisCache::Reset()
+{
+	for (const TPair<uint64, TSharedRef<FTicTacToeAnalysis, ESPMode::ThreadSafe>>& Entry : Entries)
+	{
+		Entry.Value->Cancel();
+	}
+	Entries.Reset();
+}
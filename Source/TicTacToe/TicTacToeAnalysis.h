@@ -0,0 +1,126 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeAnytimeSearch.h"
+
+/** What a candidate move leads to for the player making it */
+enum class ETicTacToeMoveVerdict : uint8
+{
+	/** Proven win */
+	Win,
+	/** Proven draw */
+	Draw,
+	/** Proven loss */
+	Loss,
+	/** Not proven within the time limit, see Value */
+	Estimate
+};
+
+/** Evaluation of one candidate move */
+struct FTicTacToeMoveAnalysis
+{
+	FTicTacToeMoveAnalysis() : BlockIndex(INDEX_NONE), Verdict(ETicTacToeMoveVerdict::Estimate), Value(0.f), Depth(0) { }
+
+	int32 BlockIndex;
+
+	ETicTacToeMoveVerdict Verdict;
+
+	/** From -1 (lost) to 1 (won) for the player making the move */
+	float Value;
+
+	/** Depth the reply was searched to */
+	int32 Depth;
+};
+
+/**
+ * Evaluates every legal move of a position, one search per move on the thread pool, except that
+ * symmetric moves on a Classic board share a search. Results can be read while the searches are
+ * still running, in the order they finish. A search hands its AI player on to the next move to be
+ * searched, so there are only ever as many AI players, and tables, as searches running at once.
+ */
+class TICTACTOE_API FTicTacToeAnalysis : public TSharedFromThis<FTicTacToeAnalysis, ESPMode::ThreadSafe>
+{
+public:
+	FTicTacToeAnalysis(const FTicTacToePosition& InPosition, const FTicTacToeAIPlayerSettings& InSettings, double InTimePerMove);
+
+	/** Queue one search per legal move */
+	void Start();
+
+	/** Stop queued and running searches, keeping the results already in */
+	void Cancel();
+
+	/** Have all moves been analysed? False after a cancel that cut some short. */
+	bool IsComplete() const;
+
+	/** Appends results that finished at or after StartIndex, returning the new total */
+	int32 CopyResults(int32 StartIndex, TArray<FTicTacToeMoveAnalysis>& OutResults) const;
+
+	FORCEINLINE const FTicTacToePosition& GetPosition() const { return Position; }
+
+private:
+
+	void AnalyseMove(int32 MoveIndex);
+
+	/** Converts the search of the reply to Move into a result for the player making Move */
+	FTicTacToeMoveAnalysis MakeResult(int32 Move, const FTicTacToePosition& Child, const FTicTacToeSearchProgress& ReplyProgress) const;
+
+	FTicTacToePosition Position;
+	FTicTacToeAIPlayerSettings Settings;
+	double TimePerMove;
+
+	int32 Moves[FTicTacToePosition::MaxMoves];
+	int32 NumMoves;
+
+	/** Index of the move searched on behalf of each move. Moves a symmetry of the position maps onto each other share one search. */
+	int32 SearchedMove[FTicTacToePosition::MaxMoves];
+
+	TAtomic<bool> bCancelled;
+
+	/** Guards everything below */
+	mutable FCriticalSection Mutex;
+
+	/** Searches running now, so a cancel can reach them */
+	TArray<TSharedPtr<FTicTacToeAnytimeSearch, ESPMode::ThreadSafe>> RunningSearches;
+
+	/** AI players of finished searches, freed once no search is left to run */
+	TArray<TUniquePtr<FTicTacToeAIPlayer>> IdleAIPlayers;
+
+	/** Searches queued or running */
+	int32 NumPendingSearches;
+
+	/** Finished results in completion order */
+	TArray<FTicTacToeMoveAnalysis> Results;
+};
+
+/**
+ * Recently analysed positions, so revisiting a position shows its analysis at once. Analyses are
+ * only reused under the settings and time per move they were made with.
+ */
+class TICTACTOE_API FTicTacToeAnalysisCache
+{
+public:
+	FTicTacToeAnalysisCache();
+
+	/** The cached analysis of Position, or a newly started one, forgetting everything if Settings or TimePerMove changed */
+	TSharedRef<FTicTacToeAnalysis, ESPMode::ThreadSafe> FindOrStart(const FTicTacToePosition& Position, const FTicTacToeAIPlayerSettings& InSettings, double InTimePerMove);
+
+	/** Cancel an analysis that is no longer wanted, forgetting it if it was cut short */
+	void Release(const TSharedRef<FTicTacToeAnalysis, ESPMode::ThreadSafe>& Analysis);
+
+	/** Cancel and forget everything */
+	void Reset();
+
+	/** Positions kept before the least recently used is dropped */
+	static constexpr int32 MaxEntries = 64;
+
+private:
+
+	/** Least recently used first */
+	TArray<TPair<uint64, TSharedRef<FTicTacToeAnalysis, ESPMode::ThreadSafe>>> Entries;
+
+	/** What every entry was analysed with */
+	FTicTacToeAIPlayerSettings Settings;
+	double TimePerMove;
+};
@@ -0,0 +1,163 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeAnytimeSearch.h"
+#include "Async/Async.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+FTicTacToeAnytimeSearch::FTicTacToeAnytimeSearch(const FTicTacToePosition& InPosition, const FTicTacToeAIPlayerSettings& Settings, double TimeLimit, int32 Seed)
+	: Position(InPosition)
+	, OwnedAIPlayer(MakeUnique<FTicTacToeAIPlayer>(GetSearchSettings(Settings), Seed))
+	, AIPlayer(*OwnedAIPlayer)
+	, bStopSearch(false)
+	, ProgressCount(0)
+	, bComplete(false)
+{
+	Init(TimeLimit);
+}
+
+FTicTacToeAnytimeSearch::FTicTacToeAnytimeSearch(const FTicTacToePosition& InPosition, FTicTacToeAIPlayer& InAIPlayer, double TimeLimit)
+	: Position(InPosition)
+	, AIPlayer(InAIPlayer)
+	, bStopSearch(false)
+	, ProgressCount(0)
+	, bComplete(false)
+{
+	Init(TimeLimit);
+}
+
+FTicTacToeAIPlayerSettings FTicTacToeAnytimeSearch::GetSearchSettings(FTicTacToeAIPlayerSettings Settings)
+{
+	// Caps high enough that the deadline always ends the search first
+	Settings.ClassicDepth = FTicTacToeLineTable::MaxSize * FTicTacToeLineTable::MaxSize;
+	Settings.UltimateIterations = MAX_int32;
+	Settings.QubicMaxDepth = FTicTacToeQubicBoard::NumCells;
+	Settings.QubicTimeLimit = 0.f;
+	return Settings;
+}
+
+void FTicTacToeAnytimeSearch::Init(double TimeLimit)
+{
+	Control.Deadline = FPlatformTime::Seconds() + TimeLimit;
+	Control.StopFlag = &bStopSearch;
+	Control.OnProgress = [this](const FTicTacToeSearchProgress& EngineProgress) { HandleProgress(EngineProgress); };
+	AIPlayer.SetSearchControl(&Control);
+
+	// Any legal move is better than none if the budget runs out before the first iteration
+	int32 Moves[FTicTacToePosition::MaxMoves];
+	if (!Position.IsGameOver() && Position.GenerateMoves(Moves) > 0)
+	{
+		Progress.BestMove = Moves[0];
+		Progress.PrincipalVariation.Add(Moves[0]);
+	}
+	else
+	{
+		bComplete = true;
+	}
+}
+
+void FTicTacToeAnytimeSearch::Run()
+{
+	if (IsComplete())
+		return;
+
+	FTicTacToeSearchStats Stats;
+	const int32 Move = AIPlayer.ChooseMove(Position, Stats);
+
+	FScopeLock Lock(&Mutex);
+	CheckDeadline();
+	if (!bComplete)
+	{
+		Progress.Nodes = Stats.Nodes;
+		if (Progress.BestMove != Move)
+		{
+			Progress.BestMove = Move;
+			Progress.PrincipalVariation.Reset();
+			Progress.PrincipalVariation.Add(Move);
+		}
+		bComplete = true;
+	}
+}
+
+void FTicTacToeAnytimeSearch::RunAsync()
+{
+	// The task holds a reference, so the search outlives an owner that gives up on it
+	TSharedRef<FTicTacToeAnytimeSearch, ESPMode::ThreadSafe> Self = AsShared();
+	Async(EAsyncExecution::ThreadPool, [Self]()
+	{
+		Self->Run();
+	});
+}
+
+void FTicTacToeAnytimeSearch::Cancel()
+{
+	bStopSearch = true;
+
+	FScopeLock Lock(&Mutex);
+	bComplete = true;
+}
+
+bool FTicTacToeAnytimeSearch::IsComplete() const
+{
+	FScopeLock Lock(&Mutex);
+	CheckDeadline();
+	return bComplete;
+}
+
+int32 FTicTacToeAnytimeSearch::GetBestMove() const
+{
+	FScopeLock Lock(&Mutex);
+	CheckDeadline();
+	return Progress.BestMove;
+}
+
+FTicTacToeSearchProgress FTicTacToeAnytimeSearch::GetProgress() const
+{
+	FScopeLock Lock(&Mutex);
+	CheckDeadline();
+	return Progress;
+}
+
+int32 FTicTacToeAnytimeSearch::GetProgressCount() const
+{
+	FScopeLock Lock(&Mutex);
+	return ProgressCount;
+}
+
+void FTicTacToeAnytimeSearch::HandleProgress(const FTicTacToeSearchProgress& EngineProgress)
+{
+	FTicTacToeSearchProgress BlockProgress = EngineProgress;
+
+	// Only Ultimate numbers its moves differently from the grid
+	if (Position.Mode == ETicTacToeGridMode::Ultimate)
+	{
+		BlockProgress.BestMove = FTicTacToeUltimateBoard::GridIndexFromMove(BlockProgress.BestMove);
+		for (int32& Move : BlockProgress.PrincipalVariation)
+		{
+			Move = FTicTacToeUltimateBoard::GridIndexFromMove(Move);
+		}
+	}
+
+	{
+		FScopeLock Lock(&Mutex);
+		CheckDeadline();
+		if (bComplete)
+			return;
+
+		Progress = BlockProgress;
+		ProgressCount++;
+	}
+
+	if (OnProgress)
+	{
+		OnProgress(BlockProgress);
+	}
+}
+
+void FTicTacToeAnytimeSearch::CheckDeadline() const
+{
+	if (!bComplete && FPlatformTime::Seconds() >= Control.Deadline)
+	{
+		bComplete = true;
+	}
+}
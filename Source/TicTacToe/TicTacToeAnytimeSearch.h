@@ -0,0 +1,86 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeAIPlayer.h"
+
+/**
+ * One AI move decision under a hard wall-clock budget. The budget starts when the search is
+ * created, a legal best move is available at any time, and once the deadline passes the
+ * answer no longer changes even if the searching thread has not yet unwound.
+ *
+ * Progress reports carry principal variations as grid block indices.
+ */
+class TICTACTOE_API FTicTacToeAnytimeSearch : public TSharedFromThis<FTicTacToeAnytimeSearch, ESPMode::ThreadSafe>
+{
+public:
+	/** Depth and iteration caps of Settings are lifted so only TimeLimit bounds the search */
+	FTicTacToeAnytimeSearch(const FTicTacToePosition& InPosition, const FTicTacToeAIPlayerSettings& Settings, double TimeLimit, int32 Seed);
+
+	/**
+	 * Searches with a lent AI player, made with GetSearchSettings, so its tables serve many searches.
+	 * It must outlive the search and search nothing else until the search has run.
+	 */
+	FTicTacToeAnytimeSearch(const FTicTacToePosition& InPosition, FTicTacToeAIPlayer& InAIPlayer, double TimeLimit);
+
+	/** Settings with the depth and iteration caps lifted */
+	static FTicTacToeAIPlayerSettings GetSearchSettings(FTicTacToeAIPlayerSettings Settings);
+
+	/** Search on the calling thread until the search completes or the deadline passes */
+	void Run();
+
+	/** Search on a pool thread, returning at once */
+	void RunAsync();
+
+	/** Stop searching, keeping the best move found so far */
+	void Cancel();
+
+	/** Has the search finished, been cancelled or run out of time? */
+	bool IsComplete() const;
+
+	/** Best block found so far, always legal in the searched position */
+	int32 GetBestMove() const;
+
+	/** Latest progress report, BestMove and PrincipalVariation as block indices */
+	FTicTacToeSearchProgress GetProgress() const;
+
+	/** Number of progress reports so far, to tell when GetProgress has changed */
+	int32 GetProgressCount() const;
+
+	FORCEINLINE double GetDeadline() const { return Control.Deadline; }
+
+	/** Optional callback on the searching thread after each report, set before running */
+	TFunction<void(const FTicTacToeSearchProgress&)> OnProgress;
+
+private:
+
+	/** Hooks the search up to AIPlayer and starts the clock */
+	void Init(double TimeLimit);
+
+	void HandleProgress(const FTicTacToeSearchProgress& EngineProgress);
+
+	/** Freeze the answer once the deadline has passed. Mutex must be held. */
+	void CheckDeadline() const;
+
+	FTicTacToePosition Position;
+
+	/** Set unless the AI player is lent */
+	TUniquePtr<FTicTacToeAIPlayer> OwnedAIPlayer;
+
+	/** Only touched by the searching thread */
+	FTicTacToeAIPlayer& AIPlayer;
+
+	FTicTacToeSearchControl Control;
+
+	TAtomic<bool> bStopSearch;
+
+	/** Guards everything below */
+	mutable FCriticalSection Mutex;
+
+	FTicTacToeSearchProgress Progress;
+	int32 ProgressCount;
+
+	/** Set once the answer can no longer change */
+	mutable bool bComplete;
+};
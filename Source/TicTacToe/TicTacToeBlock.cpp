@@ -6,6 +6,7 @@
 #include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
 #include "Materials/MaterialInstance.h"
+#include "Materials/MaterialInstanceDynamic.h"
 
 ATicTacToeBlock::ATicTacToeBlock()
 {
@@ -47,7 +48,10 @@ ATicTacToeBlock::ATicTacToeBlock()
 	P2Material = ConstructorStatics.P2Material.Get();
 
 	// Initialize block active state
+	BlockIndex = 0;
 	isActive = false;
+	isShowingAnalysis = false;
+	AnalysisMaterial = nullptr;
 
 	// Initialize ownership
 	p1Owned = false;
@@ -73,6 +77,15 @@ void ATicTacToeBlock::HandleClicked()
 	if (OwningGrid->gameCompleted)
 		return;
 
+	// Ignore blocks the rules don't allow, or clicks during the AI's turn
+	if (!OwningGrid->CanClaimBlock(BlockIndex))
+		return;
+
+	Claim();
+}
+
+void ATicTacToeBlock::Claim()
+{
 	// Check if block is not already active
 	if (!isActive)
 	{
@@ -90,10 +103,12 @@ void ATicTacToeBlock::HandleClicked()
 		}
 
 		isActive = true;
+		isShowingAnalysis = false;
 
 		// Tell the Grid
 		if (OwningGrid != nullptr)
 		{
+			OwningGrid->RecordMove(BlockIndex);
 			OwningGrid->SwitchPlayers();
 			OwningGrid->DetermineWinner();
 		}
@@ -108,6 +123,10 @@ void ATicTacToeBlock::Highlight(bool bOn)
 
 	if (bOn) // if hovering over...
 	{
+		// Only preview moves the current player may make
+		if (!OwningGrid->CanClaimBlock(BlockIndex))
+			return;
+
 		if (OwningGrid->isP1) // Is Player 1?
 		{
 			// Change to Player 1 Material for preview selection
@@ -122,7 +141,7 @@ void ATicTacToeBlock::Highlight(bool bOn)
 	else // not hovering over...
 	{
 		// Return back to current material before hover
-		BlockMesh->SetMaterial(0, BaseMaterial);
+		BlockMesh->SetMaterial(0, isShowingAnalysis ? static_cast<UMaterialInterface*>(AnalysisMaterial) : BaseMaterial);
 	}
 }
 
@@ -135,3 +154,30 @@ void ATicTacToeBlock::DispatchMaterialChange(int32 index, UMaterialInterface* ma
 {
 	BlockMesh->SetMaterial(index, material);
 }
+
+void ATicTacToeBlock::ShowAnalysis(const FLinearColor& color)
+{
+	if (isActive)
+		return;
+
+	// The base material exposes its colour as a parameter, so a dynamic instance can tint it
+	if (AnalysisMaterial == nullptr)
+	{
+		AnalysisMaterial = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+	}
+	AnalysisMaterial->SetVectorParameterValue(TEXT("DiffuseColor"), color);
+	BlockMesh->SetMaterial(0, AnalysisMaterial);
+	isShowingAnalysis = true;
+}
+
+void ATicTacToeBlock::ClearAnalysis()
+{
+	if (!isShowingAnalysis)
+		return;
+
+	isShowingAnalysis = false;
+	if (!isActive)
+	{
+		BlockMesh->SetMaterial(0, BaseMaterial);
+	}
+}
@@ -24,6 +24,9 @@ public:
 	ATicTacToeBlock();
 	~ATicTacToeBlock();
 
+	/** Index of this block within the grid */
+	int32 BlockIndex;
+
 	/** Are we currently active? */
 	bool isActive;
 
@@ -43,6 +46,13 @@ public:
 	UPROPERTY()
 	class UMaterialInstance* P2Material;
 
+	/** Evaluation colour shown while the block is empty, created on first use */
+	UPROPERTY()
+	class UMaterialInstanceDynamic* AnalysisMaterial;
+
+	/** Is the analysis colour showing? */
+	bool isShowingAnalysis;
+
 	/** Grid that owns us */
 	UPROPERTY()
 	class ATicTacToeBlockGrid* OwningGrid;
@@ -57,6 +67,9 @@ public:
 
 	void HandleClicked();
 
+	/** Claim the block for the player whose turn it is */
+	void Claim();
+
 	void Highlight(bool bOn);
 
 	/** Handles destroy of block */
@@ -65,6 +78,12 @@ public:
 	/** Handles change to win material */
 	void DispatchMaterialChange(int32 index, UMaterialInterface* material);
 
+	/** Tint an empty block with its move evaluation */
+	void ShowAnalysis(const FLinearColor& color);
+
+	/** Return an empty block to the base material */
+	void ClearAnalysis();
+
 public:
 
 	/** Returns DummyRoot subobject **/
@@ -49,10 +49,27 @@ ATicTacToeBlockGrid::ATicTacToeBlockGrid()
 	totalBlocks = Size * Size;
 	destroyDelay = 2.f;
 	spawnDelay = 3.f;
+	GridMode = ETicTacToeGridMode::Classic;
+
+	// AI defaults
+	bPlayer2IsAI = false;
+	AISearchDepth = 9;
+	AISearchThreads = 1;
+	AIIterations = 20000;
+	AITimeLimit = 0.5f;
+
+	// Analysis defaults
+	bShowAnalysis = false;
+	AnalysisTimePerMove = 0.25f;
+	shownAnalysisResults = 0;
+
+	// Full games by default
+	PuzzleWinIn = 0;
 
 	// Initialize players
 	isP1 = true;
 	isP2 = false;
+	startingPlayer = 1;
 
 	// Initialize game state
 	gameCompleted = false;
@@ -67,9 +84,38 @@ void ATicTacToeBlockGrid::BeginPlay()
 
 	destroyDelegate.BindUFunction(this, FName("OnTimerDestroy"));
 	spawnDelegate.BindUFunction(this, FName("OnTimerSpawn"));
+
+	// Create the AI player
+	if (bPlayer2IsAI)
+	{
+		ponderer = MakeUnique<FTicTacToePonderer>(GetAISettings(), FMath::Rand());
+	}
+
+	// Open the puzzle pack, falling back to full games without puzzles for this grid
+	if (GridMode == ETicTacToeGridMode::Classic && PuzzleWinIn > 0)
+	{
+		puzzlePack = MakeUnique<FTicTacToePuzzlePack>();
+		if (!puzzlePack->Open(FTicTacToePuzzlePack::GetDefaultPath(PuzzleWinIn)) || puzzlePack->GetNumPuzzles(GetBlocksPerSide()) == 0)
+		{
+			DebugMessage(FColor::Red, FString::Printf(TEXT("No win in %d puzzles for a %dx%d grid"), PuzzleWinIn, GetBlocksPerSide(), GetBlocksPerSide()));
+			puzzlePack.Reset();
+		}
+	}
+
 	SpawnBlocks();
 }
 
+void ATicTacToeBlockGrid::EndPlay(const EEndPlayReason::Type endPlayReason)
+{
+	// Joins the worker thread
+	ponderer.Reset();
+	analysisCache.Reset();
+	shownAnalysis.Reset();
+	puzzlePack.Reset();
+
+	Super::EndPlay(endPlayReason);
+}
+
 void ATicTacToeBlockGrid::Tick(float deltaSeconds)
 {
 	Super::Tick(deltaSeconds);
@@ -81,6 +127,16 @@ void ATicTacToeBlockGrid::Tick(float deltaSeconds)
 		GetWorldTimerManager().SetTimer(spawnTimerHandle, spawnDelegate, spawnDelay, false);
 		endGame = false;
 	}
+
+	// Claim the AI's move once the worker has found it, never waiting on the search.
+	// Player 2 may have been made an AI after BeginPlay, which left it without a worker.
+	int32 aiBlockIndex;
+	if (!gameCompleted && IsAITurn() && ponderer && blocksOnGrid.Num() == totalBlocks && ponderer->PollMove(aiBlockIndex) && position.IsLegal(aiBlockIndex))
+	{
+		blocksOnGrid[aiBlockIndex]->Claim();
+	}
+
+	UpdateAnalysis();
 }
 
 
@@ -125,242 +181,323 @@ void ATicTacToeBlockGrid::SwitchPlayersByWin(int32 playerPosition)
 
 bool ATicTacToeBlockGrid::Player1WinCheck()
 {
-	//** NOTE: Look into a better way for automation of win conditions based on grid size **//
+	return WinCheck(1);
+}
 
-	if ((blocksOnGrid[6]->p1Owned && blocksOnGrid[7]->p1Owned && blocksOnGrid[8]->p1Owned))
-	{
-		blocksOnGrid[6]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[7]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[8]->DispatchMaterialChange(0, WinMaterial);
+bool ATicTacToeBlockGrid::Player2WinCheck()
+{
+	return WinCheck(2);
+}
 
-		DebugMessage(FColor::Yellow, "Player 1 Wins!");
-		AddScore(1);
-		SwitchPlayersByWin(1);
-		gameCompleted = endGame = true;
-		return true;
-	}
-	else if ((blocksOnGrid[3]->p1Owned && blocksOnGrid[4]->p1Owned && blocksOnGrid[5]->p1Owned))
+bool ATicTacToeBlockGrid::WinCheck(int32 playerPosition)
+{
+	// Gather the player's blocks into a mask so each line is one AND and compare
+	uint64 owned = 0;
+	for (int32 BlockIndex = 0; BlockIndex < totalBlocks; BlockIndex++)
 	{
-		blocksOnGrid[3]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[4]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[5]->DispatchMaterialChange(0, WinMaterial);
-
-		DebugMessage(FColor::Yellow, "Player 1 Wins!");
-		AddScore(1);
-		SwitchPlayersByWin(1);
-		gameCompleted = endGame = true;
-		return true;
+		const ATicTacToeBlock* block = blocksOnGrid[BlockIndex];
+		if (playerPosition == 1 ? block->p1Owned : block->p2Owned)
+		{
+			owned |= 1ull << BlockIndex;
+		}
 	}
-	else if ((blocksOnGrid[0]->p1Owned && blocksOnGrid[1]->p1Owned && blocksOnGrid[2]->p1Owned))
-	{
-		blocksOnGrid[0]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[1]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[2]->DispatchMaterialChange(0, WinMaterial);
 
-		DebugMessage(FColor::Yellow, "Player 1 Wins!");
-		AddScore(1);
-		SwitchPlayersByWin(1);
-		gameCompleted = endGame = true;
-		return true;
-	}
-	else if ((blocksOnGrid[0]->p1Owned && blocksOnGrid[3]->p1Owned && blocksOnGrid[6]->p1Owned))
+	for (uint64 line : GetWinningLines())
 	{
-		blocksOnGrid[0]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[3]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[6]->DispatchMaterialChange(0, WinMaterial);
+		if ((owned & line) != line)
+			continue;
 
-		DebugMessage(FColor::Yellow, "Player 1 Wins!");
-		AddScore(1);
-		SwitchPlayersByWin(1);
-		gameCompleted = endGame = true;
-		return true;
-	}
-	else if ((blocksOnGrid[1]->p1Owned && blocksOnGrid[4]->p1Owned && blocksOnGrid[7]->p1Owned))
-	{
-		blocksOnGrid[1]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[4]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[7]->DispatchMaterialChange(0, WinMaterial);
+		for (uint64 cells = line; cells; cells &= cells - 1)
+		{
+			blocksOnGrid[FMath::CountTrailingZeros64(cells)]->DispatchMaterialChange(0, WinMaterial);
+		}
 
-		DebugMessage(FColor::Yellow, "Player 1 Wins!");
-		AddScore(1);
-		SwitchPlayersByWin(1);
+		DebugMessage(playerPosition == 1 ? FColor::Yellow : FColor::Red, FString::Printf(TEXT("Player %d Wins!"), playerPosition));
+		AddScore(playerPosition);
+		SwitchPlayersByWin(playerPosition);
 		gameCompleted = endGame = true;
 		return true;
 	}
-	else if ((blocksOnGrid[2]->p1Owned && blocksOnGrid[5]->p1Owned && blocksOnGrid[8]->p1Owned))
-	{
-		blocksOnGrid[2]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[5]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[8]->DispatchMaterialChange(0, WinMaterial);
 
-		DebugMessage(FColor::Yellow, "Player 1 Wins!");
-		AddScore(1);
-		SwitchPlayersByWin(1);
-		gameCompleted = endGame = true;
-		return true;
-	}
-	else if ((blocksOnGrid[2]->p1Owned && blocksOnGrid[4]->p1Owned && blocksOnGrid[6]->p1Owned))
+	return false;
+}
+
+const TArray<uint64>& ATicTacToeBlockGrid::GetWinningLines() const
+{
+	if (GridMode == ETicTacToeGridMode::Qubic)
+		return FTicTacToeQubicBoard::GetLines();
+
+	return FTicTacToeLineTable::Get(GetBlocksPerSide(), 3).Lines;
+}
+
+void ATicTacToeBlockGrid::DrawCheck()
+{
+	//** Draw Condition Check **//
+	int32 blocksNotOwned = 0;
+	for (int32 BlockIndex = 0; BlockIndex < totalBlocks; BlockIndex++)
 	{
-		blocksOnGrid[2]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[4]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[6]->DispatchMaterialChange(0, WinMaterial);
+		// If there is a block without either player 1 or player 2 ownership, then there is still a move to choose
+		if (!blocksOnGrid[BlockIndex]->p1Owned && !blocksOnGrid[BlockIndex]->p2Owned)
+		{
+			blocksNotOwned++;
+		}
+	}
 
-		DebugMessage(FColor::Yellow, "Player 1 Wins!");
-		AddScore(1);
-		SwitchPlayersByWin(1);
+	// Draw condition met!
+	if (blocksNotOwned == 0)
+	{
+		DebugMessage(FColor::Green, "Draw!");
 		gameCompleted = endGame = true;
-		return true;
 	}
-	else if ((blocksOnGrid[0]->p1Owned && blocksOnGrid[4]->p1Owned && blocksOnGrid[8]->p1Owned))
-	{
-		blocksOnGrid[0]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[4]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[8]->DispatchMaterialChange(0, WinMaterial);
+}
 
-		DebugMessage(FColor::Yellow, "Player 1 Wins!");
-		AddScore(1);
-		SwitchPlayersByWin(1);
-		gameCompleted = endGame = true;
-		return true;
+void ATicTacToeBlockGrid::DetermineWinner()
+{
+	if (GridMode == ETicTacToeGridMode::Ultimate)
+	{
+		UltimateWinCheck();
+		return;
 	}
 
-	return false;
+	if (Player1WinCheck())
+		return;
+
+	if (Player2WinCheck())
+		return;
+
+	DrawCheck();
 }
 
-bool ATicTacToeBlockGrid::Player2WinCheck()
+void ATicTacToeBlockGrid::UltimateWinCheck()
 {
-	//** NOTE: Look into a better way for automation of win conditions based on grid size **//
+	const FTicTacToeUltimateBoard& ultimateBoard = position.Ultimate;
+	if (!ultimateBoard.IsGameOver())
+		return;
 
-	if ((blocksOnGrid[6]->p2Owned && blocksOnGrid[7]->p2Owned && blocksOnGrid[8]->p2Owned))
+	if (ultimateBoard.Result == ETicTacToeResult::Draw)
 	{
-		blocksOnGrid[6]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[7]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[8]->DispatchMaterialChange(0, WinMaterial);
-
-		DebugMessage(FColor::Red, "Player 2 Wins!");
-		AddScore(2);
-		SwitchPlayersByWin(2);
+		DebugMessage(FColor::Green, "Draw!");
 		gameCompleted = endGame = true;
-		return true;
+		return;
 	}
-	else if ((blocksOnGrid[3]->p2Owned && blocksOnGrid[4]->p2Owned && blocksOnGrid[5]->p2Owned))
-	{
-		blocksOnGrid[3]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[4]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[5]->DispatchMaterialChange(0, WinMaterial);
 
-		DebugMessage(FColor::Red, "Player 2 Wins!");
-		AddScore(2);
-		SwitchPlayersByWin(2);
-		gameCompleted = endGame = true;
-		return true;
-	}
-	else if ((blocksOnGrid[0]->p2Owned && blocksOnGrid[1]->p2Owned && blocksOnGrid[2]->p2Owned))
-	{
-		blocksOnGrid[0]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[1]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[2]->DispatchMaterialChange(0, WinMaterial);
+	// Board side 0 is whoever moved first this game
+	const int32 side = ultimateBoard.Result == ETicTacToeResult::Player1Win ? 0 : 1;
+	const int32 playerPosition = side == 0 ? startingPlayer : 3 - startingPlayer;
 
-		DebugMessage(FColor::Red, "Player 2 Wins!");
-		AddScore(2);
-		SwitchPlayersByWin(2);
-		gameCompleted = endGame = true;
-		return true;
-	}
-	else if ((blocksOnGrid[0]->p2Owned && blocksOnGrid[3]->p2Owned && blocksOnGrid[6]->p2Owned))
+	// Light up the winner's marks in the three captured sub-boards
+	const uint32 winningLine = FTicTacToeUltimateBoard::GetWinningLine(ultimateBoard.Won[side]);
+	for (int32 subBoard = 0; subBoard < 9; subBoard++)
 	{
-		blocksOnGrid[0]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[3]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[6]->DispatchMaterialChange(0, WinMaterial);
+		if (!((winningLine >> subBoard) & 1))
+			continue;
 
-		DebugMessage(FColor::Red, "Player 2 Wins!");
-		AddScore(2);
-		SwitchPlayersByWin(2);
-		gameCompleted = endGame = true;
-		return true;
+		for (int32 cell = 0; cell < 9; cell++)
+		{
+			if ((ultimateBoard.Cells[side][subBoard] >> cell) & 1)
+			{
+				blocksOnGrid[FTicTacToeUltimateBoard::GridIndexFromMove(subBoard * 9 + cell)]->DispatchMaterialChange(0, WinMaterial);
+			}
+		}
 	}
-	else if ((blocksOnGrid[1]->p2Owned && blocksOnGrid[4]->p2Owned && blocksOnGrid[7]->p2Owned))
-	{
-		blocksOnGrid[1]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[4]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[7]->DispatchMaterialChange(0, WinMaterial);
 
-		DebugMessage(FColor::Red, "Player 2 Wins!");
-		AddScore(2);
-		SwitchPlayersByWin(2);
-		gameCompleted = endGame = true;
-		return true;
-	}
-	else if ((blocksOnGrid[2]->p2Owned && blocksOnGrid[5]->p2Owned && blocksOnGrid[8]->p2Owned))
-	{
-		blocksOnGrid[2]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[5]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[8]->DispatchMaterialChange(0, WinMaterial);
+	DebugMessage(playerPosition == 1 ? FColor::Yellow : FColor::Red, FString::Printf(TEXT("Player %d Wins!"), playerPosition));
+	AddScore(playerPosition);
+	SwitchPlayersByWin(playerPosition);
+	gameCompleted = endGame = true;
+}
 
-		DebugMessage(FColor::Red, "Player 2 Wins!");
-		AddScore(2);
-		SwitchPlayersByWin(2);
-		gameCompleted = endGame = true;
-		return true;
-	}
-	else if ((blocksOnGrid[2]->p2Owned && blocksOnGrid[4]->p2Owned && blocksOnGrid[6]->p2Owned))
-	{
-		blocksOnGrid[2]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[4]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[6]->DispatchMaterialChange(0, WinMaterial);
+bool ATicTacToeBlockGrid::CanClaimBlock(int32 blockIndex) const
+{
+	// Human input waits while the AI is thinking
+	if (IsAITurn())
+		return false;
 
-		DebugMessage(FColor::Red, "Player 2 Wins!");
-		AddScore(2);
-		SwitchPlayersByWin(2);
-		gameCompleted = endGame = true;
-		return true;
-	}
-	else if ((blocksOnGrid[0]->p2Owned && blocksOnGrid[4]->p2Owned && blocksOnGrid[8]->p2Owned))
+	if (GridMode == ETicTacToeGridMode::Ultimate)
+		return position.IsLegal(blockIndex);
+
+	return true;
+}
+
+void ATicTacToeBlockGrid::RecordMove(int32 blockIndex)
+{
+	if (!position.IsLegal(blockIndex))
+		return;
+
+	const bool aiMoved = IsAITurn();
+	const FTicTacToeUltimateBoard ultimateBefore = position.Ultimate;
+	position.MakeMove(blockIndex);
+
+	// A captured Ultimate sub-board takes the capturing player's colour and accepts no more moves
+	const int32 subBoard = FTicTacToeUltimateBoard::MoveFromGridIndex(blockIndex) / 9;
+	const uint16 closedNow = position.Ultimate.Closed & ~ultimateBefore.Closed;
+	if (GridMode == ETicTacToeGridMode::Ultimate && ((closedNow >> subBoard) & 1))
 	{
-		blocksOnGrid[0]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[4]->DispatchMaterialChange(0, WinMaterial);
-		blocksOnGrid[8]->DispatchMaterialChange(0, WinMaterial);
+		const int32 side = ultimateBefore.GetSideToMove();
+		const bool captured = position.Ultimate.Won[side] != ultimateBefore.Won[side];
+		const bool p1Captured = captured && isP1;
+		for (int32 cell = 0; cell < 9; cell++)
+		{
+			ATicTacToeBlock* block = blocksOnGrid[FTicTacToeUltimateBoard::GridIndexFromMove(subBoard * 9 + cell)];
+			if (captured && !block->isActive)
+			{
+				block->DispatchMaterialChange(0, p1Captured ? block->P1Material : block->P2Material);
+			}
+			block->isActive = true;
+		}
+	}
 
-		DebugMessage(FColor::Red, "Player 2 Wins!");
-		AddScore(2);
-		SwitchPlayersByWin(2);
-		gameCompleted = endGame = true;
-		return true;
+	// Keep the AI thinking on the human's time, and ask for its reply once the human has moved
+	if (ponderer)
+	{
+		if (position.IsGameOver())
+		{
+			ponderer->Cancel();
+		}
+		else if (aiMoved)
+		{
+			ponderer->StartPondering(position);
+		}
+		else
+		{
+			ponderer->RequestMove(position);
+		}
 	}
+}
 
-	return false;
+bool ATicTacToeBlockGrid::IsAITurn() const
+{
+	return bPlayer2IsAI && isP2;
 }
 
-void ATicTacToeBlockGrid::DrawCheck()
+FTicTacToeAIPlayerSettings ATicTacToeBlockGrid::GetAISettings() const
 {
-	//** Draw Condition Check **//
-	int32 blocksNotOwned = 0;
-	for (int32 BlockIndex = 0; BlockIndex < totalBlocks; BlockIndex++)
+	FTicTacToeAIPlayerSettings aiSettings;
+	aiSettings.ClassicDepth = AISearchDepth;
+	aiSettings.ClassicThreads = AISearchThreads;
+	aiSettings.UltimateIterations = AIIterations;
+	aiSettings.QubicTimeLimit = AITimeLimit;
+	return aiSettings;
+}
+
+void ATicTacToeBlockGrid::SetShowAnalysis(bool bShow)
+{
+	bShowAnalysis = bShow;
+	if (!bShowAnalysis)
 	{
-		// If there is a block without either player 1 or player 2 ownership, then there is still a move to choose
-		if (!blocksOnGrid[BlockIndex]->p1Owned && !blocksOnGrid[BlockIndex]->p2Owned)
+		HideAnalysis();
+	}
+}
+
+void ATicTacToeBlockGrid::UpdateAnalysis()
+{
+	if (!bShowAnalysis || gameCompleted || blocksOnGrid.Num() != totalBlocks)
+	{
+		HideAnalysis();
+		return;
+	}
+
+	// A new position replaces the overlay, from the cache when it has been seen before
+	if (!shownAnalysis.IsValid() || shownAnalysis->GetPosition().GetKey() != position.GetKey())
+	{
+		HideAnalysis();
+		shownAnalysis = analysisCache.FindOrStart(position, GetAISettings(), AnalysisTimePerMove);
+	}
+
+	// Only results that arrived since the last frame touch the blocks
+	TArray<FTicTacToeMoveAnalysis> newResults;
+	shownAnalysisResults = shownAnalysis->CopyResults(shownAnalysisResults, newResults);
+	for (const FTicTacToeMoveAnalysis& result : newResults)
+	{
+		FLinearColor color;
+		switch (result.Verdict)
 		{
-			blocksNotOwned++;
+		case ETicTacToeMoveVerdict::Win:
+			color = FLinearColor(0.f, 0.8f, 0.f);
+			break;
+		case ETicTacToeMoveVerdict::Loss:
+			color = FLinearColor(0.8f, 0.f, 0.f);
+			break;
+		case ETicTacToeMoveVerdict::Draw:
+			color = FLinearColor(0.5f, 0.5f, 0.5f);
+			break;
+		default:
+			// Unproven moves shade from dark red through grey to dark green
+			color = result.Value >= 0.f
+				? FLinearColor::LerpUsingHSV(FLinearColor(0.3f, 0.3f, 0.3f), FLinearColor(0.f, 0.4f, 0.f), result.Value)
+				: FLinearColor::LerpUsingHSV(FLinearColor(0.3f, 0.3f, 0.3f), FLinearColor(0.4f, 0.f, 0.f), -result.Value);
+			break;
 		}
+		blocksOnGrid[result.BlockIndex]->ShowAnalysis(color);
 	}
+}
 
-	// Draw condition met!
-	if (blocksNotOwned == 0)
+void ATicTacToeBlockGrid::HideAnalysis()
+{
+	if (!shownAnalysis.IsValid())
+		return;
+
+	analysisCache.Release(shownAnalysis.ToSharedRef());
+	shownAnalysis.Reset();
+	shownAnalysisResults = 0;
+
+	for (ATicTacToeBlock* block : blocksOnGrid)
 	{
-		DebugMessage(FColor::Green, "Draw!");
-		gameCompleted = endGame = true;
+		block->ClearAnalysis();
 	}
 }
 
-void ATicTacToeBlockGrid::DetermineWinner()
+int32 ATicTacToeBlockGrid::GetBlocksPerSide() const
 {
-	if (Player1WinCheck())
-		return;
+	switch (GridMode)
+	{
+	case ETicTacToeGridMode::Ultimate:
+		return 9;
+	case ETicTacToeGridMode::Qubic:
+		return 4;
+	default:
+		// Classic grids keep one bit per block in a uint64
+		return FMath::Clamp(Size, 3, FTicTacToeLineTable::MaxSize);
+	}
+}
 
-	if (Player2WinCheck())
-		return;
+int32 ATicTacToeBlockGrid::GetTotalBlocks() const
+{
+	const int32 blocksPerSide = GetBlocksPerSide();
+	return GridMode == ETicTacToeGridMode::Qubic ? blocksPerSide * blocksPerSide * blocksPerSide : blocksPerSide * blocksPerSide;
+}
 
-	DrawCheck();
+FVector ATicTacToeBlockGrid::GetBlockOffset(int32 blockIndex) const
+{
+	switch (GridMode)
+	{
+	case ETicTacToeGridMode::Ultimate:
+	{
+		// Third size blocks grouped into sub-boards, keeping the classic footprint
+		const int32 Row = blockIndex / 9;
+		const int32 Column = blockIndex % 9;
+		const float cellSpacing = BlockSpacing / 3.f;
+		const float subBoardGap = cellSpacing * 0.25f;
+		return FVector(Row * cellSpacing + (Row / 3) * subBoardGap, Column * cellSpacing + (Column / 3) * subBoardGap, 0.f);
+	}
+	case ETicTacToeGridMode::Qubic:
+	{
+		// Layers sit in a 2x2 arrangement so the top-down camera sees every plane, each raised above the last
+		const int32 Layer = blockIndex / 16;
+		const int32 Row = (blockIndex / 4) % 4;
+		const int32 Column = blockIndex % 4;
+		const float cellSpacing = BlockSpacing / 3.f;
+		const float layerSpacing = cellSpacing * 4.5f;
+		return FVector((Layer / 2) * layerSpacing + Row * cellSpacing, (Layer % 2) * layerSpacing + Column * cellSpacing, Layer * cellSpacing * 0.5f);
+	}
+	default:
+	{
+		const int32 blocksPerSide = GetBlocksPerSide();
+		const float XOffset = (blockIndex / blocksPerSide) * BlockSpacing; // Divide by dimension
+		const float YOffset = (blockIndex % blocksPerSide) * BlockSpacing; // Modulo gives remainder
+		return FVector(XOffset, YOffset, 0.f);
+	}
+	}
 }
 
 void ATicTacToeBlockGrid::DebugMessage(FColor color, FString message)
@@ -382,14 +519,20 @@ void ATicTacToeBlockGrid::OnTimerSpawn()
 
 void ATicTacToeBlockGrid::SpawnBlocks()
 {
+	totalBlocks = GetTotalBlocks();
+
+	// Reset rules state for the new game
+	startingPlayer = isP1 ? 1 : 2;
+	position = FTicTacToePosition(GridMode, GetBlocksPerSide());
+
+	// Ultimate and Qubic blocks are a third of the size so the grid keeps the classic footprint
+	const bool isSmallBlocks = GridMode != ETicTacToeGridMode::Classic;
+
 	// Loop to spawn each block
 	for (int32 BlockIndex = 0; BlockIndex < totalBlocks; BlockIndex++)
 	{
-		const float XOffset = (BlockIndex / Size) * BlockSpacing; // Divide by dimension
-		const float YOffset = (BlockIndex % Size) * BlockSpacing; // Modulo gives remainder
-
 		// Make position vector, offset from Grid location
-		const FVector BlockLocation = FVector(XOffset, YOffset, 0.f) + GetActorLocation();
+		const FVector BlockLocation = GetBlockOffset(BlockIndex) + GetActorLocation();
 
 		// Spawn a block
 		ATicTacToeBlock* NewBlock = GetWorld()->SpawnActor<ATicTacToeBlock>(BlockLocation, FRotator(0, 0, 0));
@@ -398,13 +541,70 @@ void ATicTacToeBlockGrid::SpawnBlocks()
 		if (NewBlock != nullptr)
 		{
 			NewBlock->OwningGrid = this;
+			NewBlock->BlockIndex = BlockIndex;
+			if (isSmallBlocks)
+			{
+				NewBlock->SetActorScale3D(FVector(1.f / 3.f));
+			}
 			blocksOnGrid.Insert(NewBlock, BlockIndex);
 		}
 	}
+
+	if (puzzlePack && blocksOnGrid.Num() == totalBlocks)
+	{
+		SetUpPuzzle();
+	}
+
+	// The AI starts thinking straight away, on its own move or on the human's
+	if (ponderer)
+	{
+		if (IsAITurn())
+		{
+			ponderer->RequestMove(position);
+		}
+		else
+		{
+			ponderer->StartPondering(position);
+		}
+	}
+}
+
+void ATicTacToeBlockGrid::SetUpPuzzle()
+{
+	// Only the puzzle being played is read from disk
+	const int32 blocksPerSide = GetBlocksPerSide();
+	FTicTacToePuzzle puzzle;
+	if (!puzzlePack->LoadPuzzle(blocksPerSide, FMath::RandHelper(puzzlePack->GetNumPuzzles(blocksPerSide)), puzzle))
+		return;
+
+	// The human solves as Player 1, so Player 1 moved first exactly when the first mover is to move
+	isP1 = true;
+	isP2 = false;
+	startingPlayer = puzzle.GetBoard().GetSideToMove() == 0 ? 1 : 2;
+
+	// Replay the marks alternately from the first mover's, no line is complete in a puzzle so any order will do
+	uint64 marks[2] = { puzzle.Marks[0], puzzle.Marks[1] };
+	for (int32 side = 0; marks[side] != 0; side = 1 - side)
+	{
+		const int32 blockIndex = FMath::CountTrailingZeros64(marks[side]);
+		marks[side] &= marks[side] - 1;
+
+		ATicTacToeBlock* block = blocksOnGrid[blockIndex];
+		const bool isP1Block = (side == 0) == (startingPlayer == 1);
+		block->p1Owned = isP1Block;
+		block->p2Owned = !isP1Block;
+		block->isActive = true;
+		block->DispatchMaterialChange(0, isP1Block ? block->P1Material : block->P2Material);
+		position.MakeMove(blockIndex);
+	}
+
+	DebugMessage(FColor::Yellow, FString::Printf(TEXT("Player 1 to play and win in %d"), puzzlePack->GetWinIn()));
 }
 
 void ATicTacToeBlockGrid::RemoveBlocks()
 {
+	HideAnalysis();
+
 	// Destroy all blocks
 	for (int32 BlockIndex = 0; BlockIndex < totalBlocks; BlockIndex++)
 	{
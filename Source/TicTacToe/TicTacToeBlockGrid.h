@@ -5,6 +5,10 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "TicTacToeBlock.h"
+#include "TicTacToePosition.h"
+#include "TicTacToePonder.h"
+#include "TicTacToeAnalysis.h"
+#include "TicTacToePuzzle.h"
 #include "TicTacToeBlockGrid.generated.h"
 
 /** Class used to spawn blocks and manage score */
@@ -65,6 +69,42 @@ public:
 	UPROPERTY(Category = Timers, EditAnywhere, BlueprintReadOnly)
 	float spawnDelay;
 
+	/** Rule set for the grid */
+	UPROPERTY(Category = Grid, EditAnywhere, BlueprintReadOnly)
+	ETicTacToeGridMode GridMode;
+
+	/** Is Player 2 controlled by the AI? */
+	UPROPERTY(Category = AI, EditAnywhere, BlueprintReadOnly)
+	bool bPlayer2IsAI;
+
+	/** Search depth of the Classic mode AI */
+	UPROPERTY(Category = AI, EditAnywhere, BlueprintReadOnly)
+	int32 AISearchDepth;
+
+	/** Threads searching for the Classic mode AI, more than one shares a transposition table between them */
+	UPROPERTY(Category = AI, EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "1", ClampMax = "64"))
+	int32 AISearchThreads;
+
+	/** Playouts per move of the Ultimate mode AI */
+	UPROPERTY(Category = AI, EditAnywhere, BlueprintReadOnly)
+	int32 AIIterations;
+
+	/** Seconds per move for the Qubic mode AI */
+	UPROPERTY(Category = AI, EditAnywhere, BlueprintReadOnly)
+	float AITimeLimit;
+
+	/** Tint every empty block with how good a move it is for the player to move */
+	UPROPERTY(Category = Analysis, EditAnywhere, BlueprintReadOnly)
+	bool bShowAnalysis;
+
+	/** Seconds spent searching each candidate move */
+	UPROPERTY(Category = Analysis, EditAnywhere, BlueprintReadOnly)
+	float AnalysisTimePerMove;
+
+	/** Classic mode only, deal "win in N" puzzles from the pack for this N instead of empty boards. Zero plays full games. */
+	UPROPERTY(Category = Puzzle, EditAnywhere, BlueprintReadOnly, meta = (ClampMin = "0", ClampMax = "9"))
+	int32 PuzzleWinIn;
+
 private:
 
 	/** Total blocks on grid */
@@ -81,10 +121,31 @@ private:
 	/** Handle for block spawn timer */
 	FTimerHandle spawnTimerHandle;
 
+	/** Player position (1 or 2) that moved first this game */
+	int32 startingPlayer;
+
+	/** Rules state mirrored from the blocks, for the AI and Ultimate mode */
+	FTicTacToePosition position;
+
+	/** Searches for the AI on a worker thread, pondering while the human thinks */
+	TUniquePtr<FTicTacToePonderer> ponderer;
+
+	/** Analyses of recent positions */
+	FTicTacToeAnalysisCache analysisCache;
+
+	/** Analysis shown on the blocks, and how many of its results have been applied */
+	TSharedPtr<FTicTacToeAnalysis, ESPMode::ThreadSafe> shownAnalysis;
+	int32 shownAnalysisResults;
+
+	/** Pack the puzzles are read from one at a time, null outside puzzle mode */
+	TUniquePtr<FTicTacToePuzzlePack> puzzlePack;
+
 protected:
 	// Begin AActor interface
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type endPlayReason) override;
+
 	virtual void Tick(float deltaSeconds) override;
 	// End AActor interface
 
@@ -111,6 +172,25 @@ public:
 	/** Handle when a player wins */
 	void DetermineWinner();
 
+	/** Can the human player claim this block right now? */
+	bool CanClaimBlock(int32 blockIndex) const;
+
+	/** Update rules state after the current player claims a block */
+	void RecordMove(int32 blockIndex);
+
+	/** Is it the AI's turn to move? */
+	bool IsAITurn() const;
+
+	/** Turn the analysis overlay on or off */
+	UFUNCTION(BlueprintCallable, Category = Analysis)
+	void SetShowAnalysis(bool bShow);
+
+	/** Rules state of the game in progress */
+	FORCEINLINE const FTicTacToePosition& GetPosition() const { return position; }
+
+	/** AI strength from the grid's AI properties */
+	FTicTacToeAIPlayerSettings GetAISettings() const;
+
 	/** Handle debug message output */
 	void DebugMessage(FColor color, FString message);
 
@@ -136,6 +216,33 @@ private:
 
 	/** Handles Deletion of blocks within the grid */
 	void RemoveBlocks();
+
+	/** Claims the blocks of a random puzzle from the pack, Player 1 to move and win */
+	void SetUpPuzzle();
+
+	/** Number of blocks along each side for the current mode */
+	int32 GetBlocksPerSide() const;
+
+	/** Number of blocks spawned for the current mode */
+	int32 GetTotalBlocks() const;
+
+	/** Position of a block relative to the grid */
+	FVector GetBlockOffset(int32 blockIndex) const;
+
+	/** Check every winning line of the current mode for a player */
+	bool WinCheck(int32 playerPosition);
+
+	/** Winning lines of the current mode as block masks */
+	const TArray<uint64>& GetWinningLines() const;
+
+	/** Check if either player won or drew the Ultimate game */
+	void UltimateWinCheck();
+
+	/** Show the current position's analysis, applying results as they arrive */
+	void UpdateAnalysis();
+
+	/** Remove the analysis overlay, cancelling it if unfinished */
+	void HideAnalysis();
 };
 
 
@@ -0,0 +1,145 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeBoard.h"
+
+namespace
+{
+	/** Builds every supported line table once, on first use */
+	struct FLineTableSet
+	{
+		FTicTacToeLineTable Tables[FTicTacToeLineTable::MaxSize + 1][FTicTacToeLineTable::MaxSize + 1];
+
+		FLineTableSet()
+		{
+			for (int32 Size = 3; Size <= FTicTacToeLineTable::MaxSize; Size++)
+			{
+				for (int32 WinLength = 3; WinLength <= Size; WinLength++)
+				{
+					Build(Tables[Size][WinLength], Size, WinLength);
+				}
+			}
+		}
+
+		static void Build(FTicTacToeLineTable& Table, int32 Size, int32 WinLength)
+		{
+			Table.Size = Size;
+			Table.WinLength = WinLength;
+
+			// Row, column, diagonal and anti-diagonal directions
+			static const int32 Directions[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+
+			for (int32 Row = 0; Row < Size; Row++)
+			{
+				for (int32 Column = 0; Column < Size; Column++)
+				{
+					for (const int32* Direction : Directions)
+					{
+						const int32 EndRow = Row + Direction[0] * (WinLength - 1);
+						const int32 EndColumn = Column + Direction[1] * (WinLength - 1);
+						if (EndRow < 0 || EndRow >= Size || EndColumn < 0 || EndColumn >= Size)
+							continue;
+
+						uint64 Line = 0;
+						for (int32 Step = 0; Step < WinLength; Step++)
+						{
+							Line |= 1ull << ((Row + Direction[0] * Step) * Size + Column + Direction[1] * Step);
+						}
+						Table.Lines.Add(Line);
+					}
+				}
+			}
+
+			// Bucket the lines by the cells they cover
+			const int32 NumCells = Size * Size;
+			Table.CellLineStart.SetNumZeroed(NumCells + 1);
+			for (int32 Cell = 0; Cell < NumCells; Cell++)
+			{
+				Table.CellLineStart[Cell] = Table.CellLines.Num();
+				for (uint64 Line : Table.Lines)
+				{
+					if ((Line >> Cell) & 1)
+					{
+						Table.CellLines.Add(Line);
+					}
+				}
+			}
+			Table.CellLineStart[NumCells] = Table.CellLines.Num();
+		}
+	};
+}
+
+const FTicTacToeLineTable& FTicTacToeLineTable::Get(int32 Size, int32 WinLength)
+{
+	static const FLineTableSet TableSet;
+
+	check(Size >= 3 && Size <= MaxSize && WinLength >= 3 && WinLength <= Size);
+	return TableSet.Tables[Size][WinLength];
+}
+
+FTicTacToeBoard::FTicTacToeBoard(int32 InSize, int32 InWinLength)
+{
+	Size = InSize;
+	WinLength = InWinLength;
+	NumCells = Size * Size;
+	FullMask = NumCells == 64 ? ~0ull : (1ull << NumCells) - 1;
+	LineTable = &FTicTacToeLineTable::Get(Size, WinLength);
+
+	Reset();
+}
+
+void FTicTacToeBoard::Reset()
+{
+	Marks[0] = Marks[1] = 0;
+	MoveCount = 0;
+	Result = ETicTacToeResult::InProgress;
+}
+
+void FTicTacToeBoard::MakeMove(int32 Cell)
+{
+	checkSlow(IsEmpty(Cell) && !IsGameOver());
+
+	const int32 Player = GetSideToMove();
+	Marks[Player] |= 1ull << Cell;
+	MoveCount++;
+
+	// Only lines through the new mark can have been completed
+	if (IsWinThrough(Cell, Player))
+	{
+		Result = Player == 0 ? ETicTacToeResult::Player1Win : ETicTacToeResult::Player2Win;
+	}
+	else if (MoveCount == NumCells)
+	{
+		Result = ETicTacToeResult::Draw;
+	}
+}
+
+void FTicTacToeBoard::UndoMove(int32 Cell)
+{
+	MoveCount--;
+	Marks[MoveCount & 1] &= ~(1ull << Cell);
+	Result = ETicTacToeResult::InProgress;
+}
+
+bool FTicTacToeBoard::IsWinThrough(int32 Cell, int32 Player) const
+{
+	const uint64 Own = Marks[Player];
+	const uint64* Line = LineTable->CellLines.GetData() + LineTable->CellLineStart[Cell];
+	const uint64* LineEnd = LineTable->CellLines.GetData() + LineTable->CellLineStart[Cell + 1];
+	for (; Line != LineEnd; ++Line)
+	{
+		if ((Own & *Line) == *Line)
+			return true;
+	}
+	return false;
+}
+
+bool FTicTacToeBoard::HasWon(int32 Player) const
+{
+	const uint64 Own = Marks[Player];
+	for (uint64 Line : LineTable->Lines)
+	{
+		if ((Own & Line) == Line)
+			return true;
+	}
+	return false;
+}
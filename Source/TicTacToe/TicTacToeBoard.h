@@ -0,0 +1,101 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Outcome of a game position */
+enum class ETicTacToeResult : uint8
+{
+	InProgress,
+	Player1Win,
+	Player2Win,
+	Draw
+};
+
+/** Precomputed winning line masks for one Size x Size board needing WinLength in a row */
+struct TICTACTOE_API FTicTacToeLineTable
+{
+	/** Number of cells along each side */
+	int32 Size;
+
+	/** Number of marks in a row needed to win */
+	int32 WinLength;
+
+	/** Every winning line as a cell mask */
+	TArray<uint64> Lines;
+
+	/** Lines passing through each cell, indexed by CellLineStart[Cell] .. CellLineStart[Cell + 1] */
+	TArray<uint64> CellLines;
+	TArray<int32> CellLineStart;
+
+	/** Returns the shared table for a board shape, Size 3..8 and WinLength 3..Size */
+	static const FTicTacToeLineTable& Get(int32 Size, int32 WinLength);
+
+	/** Largest Size that fits one bit per cell in a uint64 */
+	static constexpr int32 MaxSize = 8;
+};
+
+/**
+ * Bitboard rules core for a Size x Size grid. Each player owns one uint64 with bit
+ * (Row * Size + Column) set for every claimed cell, matching the block index used by the grid.
+ * Player indices are 0 for Player 1 and 1 for Player 2.
+ */
+struct TICTACTOE_API FTicTacToeBoard
+{
+	FTicTacToeBoard(int32 InSize = 3, int32 InWinLength = 3);
+
+	/** Clear all marks, Player 1 to move */
+	void Reset();
+
+	/** Claim an empty cell for the side to move and update the result */
+	void MakeMove(int32 Cell);
+
+	/** Take back a move previously made on Cell */
+	void UndoMove(int32 Cell);
+
+	/** Does Player own a full line through Cell? */
+	bool IsWinThrough(int32 Cell, int32 Player) const;
+
+	/** Does Player own any full line? */
+	bool HasWon(int32 Player) const;
+
+	/** Mask of cells nobody has claimed */
+	FORCEINLINE uint64 GetEmptyMask() const { return ~(Marks[0] | Marks[1]) & FullMask; }
+
+	FORCEINLINE bool IsEmpty(int32 Cell) const { return (GetEmptyMask() >> Cell) & 1; }
+
+	FORCEINLINE int32 GetSideToMove() const { return MoveCount & 1; }
+
+	FORCEINLINE bool IsGameOver() const { return Result != ETicTacToeResult::InProgress; }
+
+	FORCEINLINE const FTicTacToeLineTable& GetLines() const { return *LineTable; }
+
+	/** Hash of the position, equal for equal positions of one shape. Distinct positions may collide. */
+	FORCEINLINE uint64 GetKey() const { return Marks[0] * 0x9E3779B97F4A7C15ull ^ Marks[1] * 0xC2B2AE3D27D4EB4Full; }
+
+	/** Number of cells along each side */
+	int32 Size;
+
+	/** Number of marks in a row needed to win */
+	int32 WinLength;
+
+	/** Size * Size */
+	int32 NumCells;
+
+	/** Mask with one bit per cell on the board */
+	uint64 FullMask;
+
+	/** Claimed cells per player */
+	uint64 Marks[2];
+
+	/** Moves played so far */
+	int32 MoveCount;
+
+	/** Result after the last move */
+	ETicTacToeResult Result;
+
+private:
+
+	const FTicTacToeLineTable* LineTable;
+};
@@ -0,0 +1,151 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeBotClients.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+FTicTacToeBotClients::FTicTacToeBotClients(const FTicTacToeBotSettings& InSettings)
+	: Settings(InSettings)
+{
+}
+
+FTicTacToeBotClients::~FTicTacToeBotClients()
+{
+	Disconnect();
+}
+
+int32 FTicTacToeBotClients::Connect()
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FIPv4Address Address;
+	if (!FIPv4Address::Parse(Settings.Host, Address))
+		return 0;
+
+	const TSharedRef<FInternetAddr> ServerAddress = FIPv4Endpoint(Address, Settings.Match.Port).ToInternetAddr();
+	for (int32 Index = Bots.Num(); Index < Settings.NumBots; Index++)
+	{
+		FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("TicTacToeBot"), false);
+		if (Socket == nullptr)
+			break;
+
+		// Connect blocking, then switch to polling
+		if (!Socket->Connect(*ServerAddress))
+		{
+			SocketSubsystem->DestroySocket(Socket);
+			Stats.Disconnects++;
+			continue;
+		}
+		Socket->SetNonBlocking(true);
+		Socket->SetNoDelay(true);
+
+		Bots.Add(MakeUnique<FBot>(Socket, Settings.Match, HashCombine(GetTypeHash(Settings.Seed), GetTypeHash(Index))));
+		Send(*Bots.Last(), ETicTacToeMatchMessage::Join, 0);
+	}
+
+	Stats.Connected = Bots.Num();
+	return Bots.Num();
+}
+
+void FTicTacToeBotClients::Disconnect()
+{
+	for (const TUniquePtr<FBot>& Bot : Bots)
+	{
+		Bot->Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Bot->Socket);
+	}
+	Bots.Reset();
+	Stats.Connected = 0;
+}
+
+void FTicTacToeBotClients::Tick()
+{
+	const double Now = FPlatformTime::Seconds();
+	for (int32 Index = Bots.Num() - 1; Index >= 0; Index--)
+	{
+		FBot& Bot = *Bots[Index];
+		bool bConnected = ReadMessages(Bot, Now);
+
+		if (bConnected && Bot.bInMatch && Now >= Bot.MoveTime && Bot.Position.GetSideToMove() == Bot.Side && !Bot.Position.IsGameOver())
+		{
+			int32 Moves[FTicTacToePosition::MaxMoves];
+			const int32 NumMoves = Bot.Position.GenerateMoves(Moves);
+			const int32 Move = Moves[Bot.Random.RandHelper(NumMoves)];
+			Bot.Position.MakeMove(Move);
+			bConnected = Send(Bot, ETicTacToeMatchMessage::Move, uint8(Move));
+		}
+
+		if (!bConnected)
+		{
+			Bot.Socket->Close();
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Bot.Socket);
+			Bots.RemoveAtSwap(Index);
+			Stats.Disconnects++;
+		}
+	}
+	Stats.Connected = Bots.Num();
+}
+
+bool FTicTacToeBotClients::ReadMessages(FBot& Bot, double Now)
+{
+	uint8 Buffer[64];
+	while (true)
+	{
+		int32 BytesRead = 0;
+		if (!Bot.Socket->Recv(Buffer, sizeof(Buffer), BytesRead))
+			return false;
+		if (BytesRead == 0)
+			return true;
+
+		for (int32 Index = 0; Index < BytesRead; Index++)
+		{
+			Bot.Partial[Bot.NumPartial++] = Buffer[Index];
+			if (Bot.NumPartial == 2)
+			{
+				Bot.NumPartial = 0;
+				if (!HandleMessage(Bot, ETicTacToeMatchMessage(Bot.Partial[0]), Bot.Partial[1], Now))
+					return false;
+			}
+		}
+	}
+}
+
+bool FTicTacToeBotClients::HandleMessage(FBot& Bot, ETicTacToeMatchMessage Type, uint8 Argument, double Now)
+{
+	switch (Type)
+	{
+	case ETicTacToeMatchMessage::Start:
+		Bot.Position.Reset();
+		Bot.Side = Argument;
+		Bot.bInMatch = true;
+		Bot.MoveTime = Now + Settings.ThinkTime;
+		break;
+
+	case ETicTacToeMatchMessage::Moved:
+		if (Bot.bInMatch && Bot.Position.IsLegal(Argument))
+		{
+			Bot.Position.MakeMove(Argument);
+			Bot.MoveTime = Now + Settings.ThinkTime;
+		}
+		break;
+
+	case ETicTacToeMatchMessage::End:
+		// Straight back in the queue
+		Bot.bInMatch = false;
+		Stats.MatchesPlayed++;
+		return Send(Bot, ETicTacToeMatchMessage::Join, 0);
+
+	default:
+		break;
+	}
+	return true;
+}
+
+bool FTicTacToeBotClients::Send(FBot& Bot, ETicTacToeMatchMessage Type, uint8 Argument)
+{
+	// Two bytes always fit the send buffer of a client that keeps reading
+	const uint8 Message[2] = { uint8(Type), Argument };
+	int32 BytesSent = 0;
+	return Bot.Socket->Send(Message, 2, BytesSent) && BytesSent == 2;
+}
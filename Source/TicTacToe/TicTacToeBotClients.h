@@ -0,0 +1,115 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeMatchServer.h"
+
+struct TICTACTOE_API FTicTacToeBotSettings
+{
+	FTicTacToeBotSettings()
+		: Host(TEXT("127.0.0.1"))
+		, NumBots(200)
+		, ThinkTime(0.0)
+		, Seed(0)
+	{
+	}
+
+	/** IPv4 address of the match server */
+	FString Host;
+
+	/** Port and rules, which must match the server's */
+	FTicTacToeMatchSettings Match;
+
+	/** Simulated players, each on its own connection */
+	int32 NumBots;
+
+	/** Seconds a bot waits before answering a move, to mimic a person at the grid */
+	double ThinkTime;
+
+	int32 Seed;
+};
+
+/** Counters of all bots since they connected */
+struct TICTACTOE_API FTicTacToeBotStats
+{
+	FTicTacToeBotStats()
+		: Connected(0)
+		, MatchesPlayed(0)
+		, Disconnects(0)
+	{
+	}
+
+	int32 Connected;
+
+	/** Matches finished, counted once per bot */
+	int64 MatchesPlayed;
+
+	/** Bots that lost their connection */
+	int32 Disconnects;
+};
+
+/**
+ * Headless simulated players for load testing a match server. Every bot holds its own TCP
+ * connection, queues for a match, answers with random legal moves and queues again as soon as
+ * the match ends. All bots are driven from Tick on one thread with non-blocking sockets, so a
+ * single process can put hundreds of players on a server.
+ */
+class TICTACTOE_API FTicTacToeBotClients
+{
+public:
+	explicit FTicTacToeBotClients(const FTicTacToeBotSettings& InSettings);
+	~FTicTacToeBotClients();
+
+	/** Opens every bot's connection and queues it, returning the number connected */
+	int32 Connect();
+
+	/** Closes every connection */
+	void Disconnect();
+
+	/** Reads the server's messages and sends the moves that are due */
+	void Tick();
+
+	FORCEINLINE const FTicTacToeBotStats& GetStats() const { return Stats; }
+
+private:
+
+	struct FBot
+	{
+		FBot(FSocket* InSocket, const FTicTacToeMatchSettings& Match, int32 Seed)
+			: Socket(InSocket)
+			, Position(Match.Mode, Match.Size)
+			, Random(Seed)
+			, Side(0)
+			, bInMatch(false)
+			, MoveTime(0.0)
+			, NumPartial(0)
+		{
+		}
+
+		FSocket* Socket;
+
+		/** The match being played as the bot sees it */
+		FTicTacToePosition Position;
+		FRandomStream Random;
+		int32 Side;
+		bool bInMatch;
+
+		/** When the bot's next move is due, while it is the bot's turn */
+		double MoveTime;
+
+		uint8 Partial[2];
+		int32 NumPartial;
+	};
+
+	/** These return false once the connection has failed */
+	bool ReadMessages(FBot& Bot, double Now);
+	bool HandleMessage(FBot& Bot, ETicTacToeMatchMessage Type, uint8 Argument, double Now);
+	bool Send(FBot& Bot, ETicTacToeMatchMessage Type, uint8 Argument);
+
+	FTicTacToeBotSettings Settings;
+
+	TArray<TUniquePtr<FBot>> Bots;
+
+	FTicTacToeBotStats Stats;
+};
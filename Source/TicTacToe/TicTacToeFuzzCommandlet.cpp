@@ -0,0 +1,77 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeFuzzCommandlet.h"
+#include "TicTacToe.h"
+#include "TicTacToeFuzzer.h"
+#include "HAL/PlatformTime.h"
+
+UTicTacToeFuzzCommandlet::UTicTacToeFuzzCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTicTacToeFuzzCommandlet::Main(const FString& Params)
+{
+	FTicTacToeFuzzSettings Settings;
+
+	FString Mode = TEXT("All");
+	FParse::Value(*Params, TEXT("Mode="), Mode);
+
+	if (Mode == TEXT("All"))
+	{
+		Settings.Targets = FTicTacToeFuzzSettings::GetAllTargets();
+	}
+	else if (Mode == TEXT("Classic"))
+	{
+		// Every win length of one size unless a win length is given
+		int32 Size = 3;
+		int32 WinLength = 0;
+		FParse::Value(*Params, TEXT("Size="), Size);
+		FParse::Value(*Params, TEXT("WinLength="), WinLength);
+		Size = FMath::Clamp(Size, 3, FTicTacToeLineTable::MaxSize);
+
+		for (int32 Length = 3; Length <= Size; Length++)
+		{
+			if (WinLength == 0 || Length == FMath::Clamp(WinLength, 3, Size))
+			{
+				Settings.Targets.Add(FTicTacToeFuzzTarget(ETicTacToeGridMode::Classic, Size, Length));
+			}
+		}
+	}
+	else if (Mode == TEXT("Ultimate"))
+	{
+		Settings.Targets.Add(FTicTacToeFuzzTarget(ETicTacToeGridMode::Ultimate));
+	}
+	else if (Mode == TEXT("Qubic"))
+	{
+		Settings.Targets.Add(FTicTacToeFuzzTarget(ETicTacToeGridMode::Qubic));
+	}
+	else
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("Unknown mode '%s'"), *Mode);
+		return 1;
+	}
+
+	FParse::Value(*Params, TEXT("Games="), Settings.GamesPerTarget);
+	FParse::Value(*Params, TEXT("Batch="), Settings.GamesPerBatch);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+
+	UE_LOG(LogTicTacToe, Display, TEXT("Fuzzing %d rules variants, %d games each, seed %d"),
+		Settings.Targets.Num(), Settings.GamesPerTarget, Settings.Seed);
+
+	const double StartTime = FPlatformTime::Seconds();
+	FTicTacToeFuzzer Fuzzer(Settings);
+	Fuzzer.Run();
+
+	const int32 NumMismatches = Fuzzer.GetNumMismatches();
+	UE_LOG(LogTicTacToe, Display, TEXT("Finished in %.2f s\n%s"), FPlatformTime::Seconds() - StartTime, *Fuzzer.FormatReport());
+	if (NumMismatches > 0)
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("%d mismatches between the optimized and reference rules"), NumMismatches);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TicTacToeFuzzCommandlet.generated.h"
+
+/**
+ * Cross-checks the bitboard rules against reference rules on generated games and logs
+ * throughput and any mismatches, shrunk to minimal move lists. Returns 1 on a mismatch.
+ *
+ * UE4Editor-Cmd TicTacToe -run=TicTacToeFuzz [-Mode=All|Classic|Ultimate|Qubic]
+ *     [-Size=3] [-WinLength=3] [-Games=20000] [-Batch=500] [-Seed=0]
+ */
+UCLASS()
+class UTicTacToeFuzzCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTicTacToeFuzzCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
@@ -0,0 +1,943 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeFuzzer.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	const TCHAR* GetResultName(ETicTacToeResult Result)
+	{
+		switch (Result)
+		{
+		case ETicTacToeResult::Player1Win:
+			return TEXT("Player1Win");
+		case ETicTacToeResult::Player2Win:
+			return TEXT("Player2Win");
+		case ETicTacToeResult::Draw:
+			return TEXT("Draw");
+		default:
+			return TEXT("InProgress");
+		}
+	}
+
+	const TCHAR* GetGeneratorName(ETicTacToeFuzzGenerator Generator)
+	{
+		switch (Generator)
+		{
+		case ETicTacToeFuzzGenerator::Tactical:
+			return TEXT("Tactical");
+		case ETicTacToeFuzzGenerator::EdgeBiased:
+			return TEXT("EdgeBiased");
+		case ETicTacToeFuzzGenerator::Stalling:
+			return TEXT("Stalling");
+		default:
+			return TEXT("Random");
+		}
+	}
+
+	ETicTacToeResult GetWinResult(int32 Player)
+	{
+		return Player == 0 ? ETicTacToeResult::Player1Win : ETicTacToeResult::Player2Win;
+	}
+
+	/**
+	 * Reference rules for Classic and Qubic: a Layers x Size x Size box of cells where any
+	 * WinLength cells in a straight line win. Written for obviousness, not speed.
+	 */
+	class FReferenceLineBoard
+	{
+	public:
+		FReferenceLineBoard(int32 InSize, int32 InLayers, int32 InWinLength)
+			: Size(InSize)
+			, Layers(InLayers)
+			, WinLength(InWinLength)
+		{
+			// One of each pair of opposite directions, in (layer, row, column) steps
+			for (int32 DLayer = 0; DLayer <= (Layers > 1 ? 1 : 0); DLayer++)
+			{
+				for (int32 DRow = -1; DRow <= 1; DRow++)
+				{
+					for (int32 DColumn = -1; DColumn <= 1; DColumn++)
+					{
+						const bool bForward = DLayer > 0 || DRow > 0 || (DRow == 0 && DColumn > 0);
+						if (bForward)
+						{
+							Directions.Add({ DLayer, DRow, DColumn });
+						}
+					}
+				}
+			}
+			Reset();
+		}
+
+		void Reset()
+		{
+			for (int8& Cell : Cells)
+			{
+				Cell = 0;
+			}
+			MoveCount = 0;
+			Result = ETicTacToeResult::InProgress;
+		}
+
+		int32 GetNumCells() const { return Layers * Size * Size; }
+
+		int32 GetSideToMove() const { return MoveCount % 2; }
+
+		bool IsGameOver() const { return Result != ETicTacToeResult::InProgress; }
+
+		bool IsLegal(int32 Cell) const
+		{
+			return !IsGameOver() && Cell >= 0 && Cell < GetNumCells() && Cells[Cell] == 0;
+		}
+
+		void GetMoves(TArray<int32, TInlineAllocator<81>>& OutMoves) const
+		{
+			for (int32 Cell = 0; Cell < GetNumCells(); Cell++)
+			{
+				if (IsLegal(Cell))
+				{
+					OutMoves.Add(Cell);
+				}
+			}
+		}
+
+		void Play(int32 Cell)
+		{
+			const int32 Player = GetSideToMove();
+			Cells[Cell] = int8(Player + 1);
+			MoveCount++;
+
+			if (HasLine(Player))
+			{
+				Result = GetWinResult(Player);
+			}
+			else if (MoveCount == GetNumCells())
+			{
+				Result = ETicTacToeResult::Draw;
+			}
+		}
+
+		/** Does Player own WinLength cells in a row anywhere? */
+		bool HasLine(int32 Player) const
+		{
+			for (int32 Layer = 0; Layer < Layers; Layer++)
+			{
+				for (int32 Row = 0; Row < Size; Row++)
+				{
+					for (int32 Column = 0; Column < Size; Column++)
+					{
+						for (const FDirection& Direction : Directions)
+						{
+							int32 Count = 0;
+							while (Count < WinLength && GetOwner(Layer + Direction.Layer * Count, Row + Direction.Row * Count, Column + Direction.Column * Count) == Player + 1)
+							{
+								Count++;
+							}
+							if (Count == WinLength)
+								return true;
+						}
+					}
+				}
+			}
+			return false;
+		}
+
+		/** Would claiming the empty Cell give Player a line through it? */
+		bool WouldWin(int32 Cell, int32 Player) const
+		{
+			if (Cells[Cell] != 0)
+				return false;
+
+			const int32 Layer = Cell / (Size * Size);
+			const int32 Row = (Cell / Size) % Size;
+			const int32 Column = Cell % Size;
+			for (const FDirection& Direction : Directions)
+			{
+				// Count Player's marks running away from Cell both ways
+				int32 Count = 1;
+				for (int32 Sign = -1; Sign <= 1; Sign += 2)
+				{
+					int32 Step = 1;
+					while (GetOwner(Layer + Direction.Layer * Sign * Step, Row + Direction.Row * Sign * Step, Column + Direction.Column * Sign * Step) == Player + 1)
+					{
+						Count++;
+						Step++;
+					}
+				}
+				if (Count >= WinLength)
+					return true;
+			}
+			return false;
+		}
+
+		bool IsEdge(int32 Cell) const
+		{
+			const int32 Layer = Cell / (Size * Size);
+			const int32 Row = (Cell / Size) % Size;
+			const int32 Column = Cell % Size;
+			return Row == 0 || Row == Size - 1 || Column == 0 || Column == Size - 1 || (Layers > 1 && (Layer == 0 || Layer == Layers - 1));
+		}
+
+		int8 GetCell(int32 Cell) const { return Cells[Cell]; }
+
+		ETicTacToeResult Result;
+
+	private:
+
+		struct FDirection
+		{
+			int32 Layer;
+			int32 Row;
+			int32 Column;
+		};
+
+		/** 1 or 2 for a player's mark, 0 when empty or off the board */
+		int32 GetOwner(int32 Layer, int32 Row, int32 Column) const
+		{
+			if (Layer < 0 || Layer >= Layers || Row < 0 || Row >= Size || Column < 0 || Column >= Size)
+				return 0;
+
+			return Cells[(Layer * Size + Row) * Size + Column];
+		}
+
+		int32 Size;
+		int32 Layers;
+		int32 WinLength;
+		TArray<FDirection, TInlineAllocator<13>> Directions;
+
+		int8 Cells[64];
+		int32 MoveCount;
+	};
+
+	/** Reference rules for Ultimate, with every sub-board a plain 3x3 array */
+	class FReferenceUltimateBoard
+	{
+	public:
+		FReferenceUltimateBoard()
+		{
+			Reset();
+		}
+
+		void Reset()
+		{
+			for (int32 SubBoard = 0; SubBoard < 9; SubBoard++)
+			{
+				for (int32 Cell = 0; Cell < 9; Cell++)
+				{
+					Cells[SubBoard][Cell] = 0;
+				}
+				Status[SubBoard] = Open;
+			}
+			Forced = INDEX_NONE;
+			MoveCount = 0;
+			Result = ETicTacToeResult::InProgress;
+		}
+
+		int32 GetSideToMove() const { return MoveCount % 2; }
+
+		bool IsGameOver() const { return Result != ETicTacToeResult::InProgress; }
+
+		bool IsLegal(int32 Move) const
+		{
+			if (IsGameOver() || Move < 0 || Move >= 81)
+				return false;
+
+			const int32 SubBoard = Move / 9;
+			return Status[SubBoard] == Open && (Forced == INDEX_NONE || Forced == SubBoard) && Cells[SubBoard][Move % 9] == 0;
+		}
+
+		void GetMoves(TArray<int32, TInlineAllocator<81>>& OutMoves) const
+		{
+			for (int32 Move = 0; Move < 81; Move++)
+			{
+				if (IsLegal(Move))
+				{
+					OutMoves.Add(Move);
+				}
+			}
+		}
+
+		void Play(int32 Move)
+		{
+			const int32 Player = GetSideToMove();
+			Mark(Move, Player);
+			MoveCount++;
+
+			if (HasWonGame(Player))
+			{
+				Result = GetWinResult(Player);
+			}
+			else
+			{
+				bool bAllDecided = true;
+				for (int32 SubBoard = 0; SubBoard < 9; SubBoard++)
+				{
+					bAllDecided &= Status[SubBoard] != Open;
+				}
+				if (bAllDecided)
+				{
+					Result = ETicTacToeResult::Draw;
+				}
+			}
+
+			const int32 Cell = Move % 9;
+			Forced = Status[Cell] == Open ? Cell : INDEX_NONE;
+		}
+
+		bool WouldWin(int32 Move, int32 Player) const
+		{
+			if (Status[Move / 9] != Open || Cells[Move / 9][Move % 9] != 0)
+				return false;
+
+			FReferenceUltimateBoard Copy = *this;
+			Copy.Mark(Move, Player);
+			return Copy.HasWonGame(Player);
+		}
+
+		/** On the outer ring of an outer sub-board */
+		bool IsEdge(int32 Move) const
+		{
+			return Move / 9 != 4 && Move % 9 != 4;
+		}
+
+		/** Sub-boards captured by Player */
+		uint32 GetWonMask(int32 Player) const
+		{
+			uint32 Mask = 0;
+			for (int32 SubBoard = 0; SubBoard < 9; SubBoard++)
+			{
+				if (Status[SubBoard] == Player + 1)
+				{
+					Mask |= 1u << SubBoard;
+				}
+			}
+			return Mask;
+		}
+
+		/** Sub-boards captured or full */
+		uint32 GetClosedMask() const
+		{
+			uint32 Mask = 0;
+			for (int32 SubBoard = 0; SubBoard < 9; SubBoard++)
+			{
+				if (Status[SubBoard] != Open)
+				{
+					Mask |= 1u << SubBoard;
+				}
+			}
+			return Mask;
+		}
+
+		ETicTacToeResult Result;
+
+	private:
+
+		/** Sub-board states, 1 and 2 being captured by that player */
+		enum : int8
+		{
+			Open = 0,
+			Full = 3
+		};
+
+		void Mark(int32 Move, int32 Player)
+		{
+			const int32 SubBoard = Move / 9;
+			int8* Grid = Cells[SubBoard];
+			Grid[Move % 9] = int8(Player + 1);
+
+			if (HasThreeInARow(Grid, int8(Player + 1)))
+			{
+				Status[SubBoard] = int8(Player + 1);
+			}
+			else
+			{
+				bool bFull = true;
+				for (int32 Cell = 0; Cell < 9; Cell++)
+				{
+					bFull &= Grid[Cell] != 0;
+				}
+				if (bFull)
+				{
+					Status[SubBoard] = Full;
+				}
+			}
+		}
+
+		bool HasWonGame(int32 Player) const
+		{
+			return HasThreeInARow(Status, int8(Player + 1));
+		}
+
+		static bool HasThreeInARow(const int8* Grid, int8 Owner)
+		{
+			for (int32 Index = 0; Index < 3; Index++)
+			{
+				if (Grid[Index * 3] == Owner && Grid[Index * 3 + 1] == Owner && Grid[Index * 3 + 2] == Owner)
+					return true;
+				if (Grid[Index] == Owner && Grid[Index + 3] == Owner && Grid[Index + 6] == Owner)
+					return true;
+			}
+			return (Grid[0] == Owner && Grid[4] == Owner && Grid[8] == Owner) || (Grid[2] == Owner && Grid[4] == Owner && Grid[6] == Owner);
+		}
+
+		int8 Cells[9][9];
+		int8 Status[9];
+		int32 Forced;
+		int32 MoveCount;
+	};
+
+	/** Classic bitboard against the reference */
+	class FClassicChecker
+	{
+	public:
+		explicit FClassicChecker(const FTicTacToeFuzzTarget& Target)
+			: Board(Target.Size, Target.WinLength)
+			, Reference(Target.Size, 1, Target.WinLength)
+		{
+		}
+
+		const FReferenceLineBoard& GetReference() const { return Reference; }
+
+		bool Play(int32 Move, FString& OutDescription)
+		{
+			// Searches rely on UndoMove restoring the position exactly
+			const FTicTacToeBoard Before = Board;
+			Board.MakeMove(Move);
+			const FTicTacToeBoard After = Board;
+			Board.UndoMove(Move);
+			if (Board.Marks[0] != Before.Marks[0] || Board.Marks[1] != Before.Marks[1] || Board.MoveCount != Before.MoveCount || Board.Result != Before.Result)
+			{
+				OutDescription = FString::Printf(TEXT("UndoMove(%d) did not restore the position"), Move);
+				return false;
+			}
+			Board = After;
+
+			Reference.Play(Move);
+			return Compare(OutDescription);
+		}
+
+		bool Compare(FString& OutDescription) const
+		{
+			if (Board.Result != Reference.Result)
+			{
+				OutDescription = FString::Printf(TEXT("Result is %s, reference says %s"), GetResultName(Board.Result), GetResultName(Reference.Result));
+				return false;
+			}
+
+			for (int32 Cell = 0; Cell < Board.NumCells; Cell++)
+			{
+				const int8 Expected = Reference.GetCell(Cell);
+				const int8 Actual = (Board.Marks[0] >> Cell) & 1 ? 1 : ((Board.Marks[1] >> Cell) & 1 ? 2 : 0);
+				if (Actual != Expected)
+				{
+					OutDescription = FString::Printf(TEXT("Cell %d holds %d, reference says %d"), Cell, Actual, Expected);
+					return false;
+				}
+			}
+
+			for (int32 Player = 0; Player < 2; Player++)
+			{
+				if (Board.HasWon(Player) != Reference.HasLine(Player))
+				{
+					OutDescription = FString::Printf(TEXT("HasWon(%d) is %d, reference says %d"), Player, Board.HasWon(Player), Reference.HasLine(Player));
+					return false;
+				}
+
+				if (Board.IsGameOver())
+					continue;
+
+				// FindWinningCell may pick any winning cell, but must find one when one exists
+				const int32 Found = FTicTacToeEngine::FindWinningCell(Board, Player);
+				if (Found != INDEX_NONE && !Reference.WouldWin(Found, Player))
+				{
+					OutDescription = FString::Printf(TEXT("FindWinningCell(%d) returned %d, which does not win"), Player, Found);
+					return false;
+				}
+				if (Found == INDEX_NONE)
+				{
+					for (int32 Cell = 0; Cell < Board.NumCells; Cell++)
+					{
+						if (Reference.WouldWin(Cell, Player))
+						{
+							OutDescription = FString::Printf(TEXT("FindWinningCell(%d) found nothing, but %d wins"), Player, Cell);
+							return false;
+						}
+					}
+				}
+			}
+			return true;
+		}
+
+	private:
+		FTicTacToeBoard Board;
+		FReferenceLineBoard Reference;
+	};
+
+	/** Qubic bitboard against the reference */
+	class FQubicChecker
+	{
+	public:
+		explicit FQubicChecker(const FTicTacToeFuzzTarget& /*Target*/)
+			: Reference(4, 4, 4)
+		{
+		}
+
+		const FReferenceLineBoard& GetReference() const { return Reference; }
+
+		bool Play(int32 Move, FString& OutDescription)
+		{
+			const FTicTacToeQubicBoard Before = Board;
+			Board.MakeMove(Move);
+			const FTicTacToeQubicBoard After = Board;
+			Board.UndoMove(Move);
+			if (Board.Marks[0] != Before.Marks[0] || Board.Marks[1] != Before.Marks[1] || Board.MoveCount != Before.MoveCount || Board.Result != Before.Result)
+			{
+				OutDescription = FString::Printf(TEXT("UndoMove(%d) did not restore the position"), Move);
+				return false;
+			}
+			Board = After;
+
+			Reference.Play(Move);
+			return Compare(OutDescription);
+		}
+
+		bool Compare(FString& OutDescription) const
+		{
+			if (Board.Result != Reference.Result)
+			{
+				OutDescription = FString::Printf(TEXT("Result is %s, reference says %s"), GetResultName(Board.Result), GetResultName(Reference.Result));
+				return false;
+			}
+
+			for (int32 Cell = 0; Cell < FTicTacToeQubicBoard::NumCells; Cell++)
+			{
+				const int8 Expected = Reference.GetCell(Cell);
+				const int8 Actual = (Board.Marks[0] >> Cell) & 1 ? 1 : ((Board.Marks[1] >> Cell) & 1 ? 2 : 0);
+				if (Actual != Expected)
+				{
+					OutDescription = FString::Printf(TEXT("Cell %d holds %d, reference says %d"), Cell, Actual, Expected);
+					return false;
+				}
+			}
+
+			if (Board.IsGameOver())
+				return true;
+
+			// The AI prunes on threats, so every empty cell must be classified exactly
+			for (int32 Player = 0; Player < 2; Player++)
+			{
+				const uint64 Threats = Board.GetThreats(Player) & Board.GetEmptyMask();
+				for (int32 Cell = 0; Cell < FTicTacToeQubicBoard::NumCells; Cell++)
+				{
+					const bool bThreat = (Threats >> Cell) & 1;
+					if (bThreat != Reference.WouldWin(Cell, Player))
+					{
+						OutDescription = FString::Printf(TEXT("GetThreats(%d) %s cell %d"), Player, bThreat ? TEXT("wrongly includes") : TEXT("misses"), Cell);
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+
+	private:
+		FTicTacToeQubicBoard Board;
+		FReferenceLineBoard Reference;
+	};
+
+	/** Ultimate bitboard against the reference */
+	class FUltimateChecker
+	{
+	public:
+		explicit FUltimateChecker(const FTicTacToeFuzzTarget& /*Target*/)
+		{
+		}
+
+		const FReferenceUltimateBoard& GetReference() const { return Reference; }
+
+		bool Play(int32 Move, FString& OutDescription)
+		{
+			Board.MakeMove(Move);
+			Reference.Play(Move);
+			return Compare(OutDescription);
+		}
+
+		bool Compare(FString& OutDescription) const
+		{
+			if (Board.Result != Reference.Result)
+			{
+				OutDescription = FString::Printf(TEXT("Result is %s, reference says %s"), GetResultName(Board.Result), GetResultName(Reference.Result));
+				return false;
+			}
+
+			for (int32 Player = 0; Player < 2; Player++)
+			{
+				if (Board.Won[Player] != Reference.GetWonMask(Player))
+				{
+					OutDescription = FString::Printf(TEXT("Player %d captured 0x%03x, reference says 0x%03x"), Player, Board.Won[Player], Reference.GetWonMask(Player));
+					return false;
+				}
+			}
+
+			if (Board.Closed != Reference.GetClosedMask())
+			{
+				OutDescription = FString::Printf(TEXT("Closed is 0x%03x, reference says 0x%03x"), Board.Closed, Reference.GetClosedMask());
+				return false;
+			}
+
+			// Generated moves must be exactly the legal ones, in any order
+			uint8 Moves[81];
+			const int32 NumMoves = Board.GenerateMoves(Moves);
+			bool bGenerated[81] = {};
+			for (int32 Index = 0; Index < NumMoves; Index++)
+			{
+				bGenerated[Moves[Index]] = true;
+			}
+
+			for (int32 Move = 0; Move < 81; Move++)
+			{
+				const bool bLegal = Reference.IsLegal(Move);
+				if (Board.IsLegal(Move) != bLegal)
+				{
+					OutDescription = FString::Printf(TEXT("IsLegal(%d) is %d, reference says %d"), Move, !bLegal, bLegal);
+					return false;
+				}
+				if (!Board.IsGameOver() && bGenerated[Move] != bLegal)
+				{
+					OutDescription = FString::Printf(TEXT("GenerateMoves %s move %d"), bLegal ? TEXT("misses") : TEXT("wrongly includes"), Move);
+					return false;
+				}
+			}
+			return true;
+		}
+
+	private:
+		FTicTacToeUltimateBoard Board;
+		FReferenceUltimateBoard Reference;
+	};
+
+	template<typename TReference>
+	int32 PickMove(const TReference& Reference, ETicTacToeFuzzGenerator Generator, FRandomStream& Random)
+	{
+		TArray<int32, TInlineAllocator<81>> Moves;
+		Reference.GetMoves(Moves);
+
+		const int32 Side = Reference.GetSideToMove();
+		TArray<int32, TInlineAllocator<81>> Preferred;
+		switch (Generator)
+		{
+		case ETicTacToeFuzzGenerator::Tactical:
+			for (int32 Move : Moves)
+			{
+				if (Reference.WouldWin(Move, Side))
+					return Move;
+			}
+			for (int32 Move : Moves)
+			{
+				if (Reference.WouldWin(Move, Side ^ 1))
+					return Move;
+			}
+			break;
+		case ETicTacToeFuzzGenerator::EdgeBiased:
+			if (Random.RandHelper(4) != 0)
+			{
+				for (int32 Move : Moves)
+				{
+					if (Reference.IsEdge(Move))
+					{
+						Preferred.Add(Move);
+					}
+				}
+			}
+			break;
+		case ETicTacToeFuzzGenerator::Stalling:
+			for (int32 Move : Moves)
+			{
+				if (!Reference.WouldWin(Move, Side))
+				{
+					Preferred.Add(Move);
+				}
+			}
+			break;
+		default:
+			break;
+		}
+
+		const TArray<int32, TInlineAllocator<81>>& Choices = Preferred.Num() > 0 ? Preferred : Moves;
+		return Choices[Random.RandHelper(Choices.Num())];
+	}
+
+	/** Plays one generated game on both implementations, stopping at the first disagreement */
+	template<typename TChecker>
+	bool PlayGame(const FTicTacToeFuzzTarget& Target, ETicTacToeFuzzGenerator Generator, FRandomStream& Random, TArray<int32>& OutMoves, FString& OutDescription)
+	{
+		TChecker Checker(Target);
+		if (!Checker.Compare(OutDescription))
+			return false;
+
+		while (!Checker.GetReference().IsGameOver())
+		{
+			const int32 Move = PickMove(Checker.GetReference(), Generator, Random);
+			OutMoves.Add(Move);
+			if (!Checker.Play(Move, OutDescription))
+				return false;
+		}
+		return true;
+	}
+
+	template<typename TChecker>
+	bool ReplayGame(const FTicTacToeFuzzTarget& Target, const TArray<int32>& Moves, FString& OutDescription)
+	{
+		TChecker Checker(Target);
+		if (!Checker.Compare(OutDescription))
+			return false;
+
+		for (int32 Move : Moves)
+		{
+			// A sequence the rules do not allow says nothing about the optimized board
+			if (!Checker.GetReference().IsLegal(Move))
+				return true;
+
+			if (!Checker.Play(Move, OutDescription))
+				return false;
+		}
+		return true;
+	}
+}
+
+FString FTicTacToeFuzzTarget::ToString() const
+{
+	switch (Mode)
+	{
+	case ETicTacToeGridMode::Ultimate:
+		return TEXT("Ultimate");
+	case ETicTacToeGridMode::Qubic:
+		return TEXT("Qubic");
+	default:
+		return FString::Printf(TEXT("Classic %dx%d, %d in a row"), Size, Size, WinLength);
+	}
+}
+
+TArray<FTicTacToeFuzzTarget> FTicTacToeFuzzSettings::GetAllTargets()
+{
+	TArray<FTicTacToeFuzzTarget> Targets;
+	for (int32 Size = 3; Size <= FTicTacToeLineTable::MaxSize; Size++)
+	{
+		for (int32 WinLength = 3; WinLength <= Size; WinLength++)
+		{
+			Targets.Add(FTicTacToeFuzzTarget(ETicTacToeGridMode::Classic, Size, WinLength));
+		}
+	}
+	Targets.Add(FTicTacToeFuzzTarget(ETicTacToeGridMode::Ultimate));
+	Targets.Add(FTicTacToeFuzzTarget(ETicTacToeGridMode::Qubic));
+	return Targets;
+}
+
+FTicTacToeFuzzer::FTicTacToeFuzzer(const FTicTacToeFuzzSettings& InSettings)
+	: Settings(InSettings)
+{
+	Settings.GamesPerBatch = FMath::Max(1, Settings.GamesPerBatch);
+}
+
+void FTicTacToeFuzzer::Run()
+{
+	Reports.Reset();
+
+	// Targets run one after another so each gets its own throughput figure
+	for (int32 TargetIndex = 0; TargetIndex < Settings.Targets.Num(); TargetIndex++)
+	{
+		TArray<FBatch> Batches;
+		int32 BatchIndex = 0;
+		for (int32 GamesLeft = Settings.GamesPerTarget; GamesLeft > 0; GamesLeft -= Settings.GamesPerBatch)
+		{
+			FBatch& Batch = Batches.AddDefaulted_GetRef();
+			Batch.TargetIndex = TargetIndex;
+			Batch.BatchIndex = BatchIndex++;
+			Batch.NumGames = FMath::Min(GamesLeft, Settings.GamesPerBatch);
+			Batch.GamesPlayed = 0;
+			Batch.Moves = 0;
+			Batch.bMismatch = false;
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		ParallelFor(Batches.Num(), [this, &Batches](int32 Index)
+		{
+			RunBatch(Batches[Index]);
+		});
+
+		FTicTacToeFuzzReport& Report = Reports.AddDefaulted_GetRef();
+		Report.Target = Settings.Targets[TargetIndex];
+		Report.Seconds = FPlatformTime::Seconds() - StartTime;
+		for (const FBatch& Batch : Batches)
+		{
+			Report.Games += Batch.GamesPlayed;
+			Report.Moves += Batch.Moves;
+			if (Batch.bMismatch)
+			{
+				Report.Mismatches.Add(Batch.Mismatch);
+			}
+		}
+	}
+}
+
+void FTicTacToeFuzzer::RunBatch(FBatch& Batch) const
+{
+	const FTicTacToeFuzzTarget& Target = Settings.Targets[Batch.TargetIndex];
+	FRandomStream Random(HashCombine(HashCombine(GetTypeHash(Settings.Seed), GetTypeHash(Batch.TargetIndex)), GetTypeHash(Batch.BatchIndex)));
+
+	TArray<int32> Moves;
+	FString Description;
+	for (int32 Game = 0; Game < Batch.NumGames; Game++)
+	{
+		// Cycle through the generators so every batch mixes them
+		const ETicTacToeFuzzGenerator Generator = ETicTacToeFuzzGenerator((Batch.BatchIndex * Settings.GamesPerBatch + Game) % int32(ETicTacToeFuzzGenerator::Count));
+		Moves.Reset();
+
+		bool bAgreed;
+		switch (Target.Mode)
+		{
+		case ETicTacToeGridMode::Ultimate:
+			bAgreed = PlayGame<FUltimateChecker>(Target, Generator, Random, Moves, Description);
+			break;
+		case ETicTacToeGridMode::Qubic:
+			bAgreed = PlayGame<FQubicChecker>(Target, Generator, Random, Moves, Description);
+			break;
+		default:
+			bAgreed = PlayGame<FClassicChecker>(Target, Generator, Random, Moves, Description);
+			break;
+		}
+
+		Batch.GamesPlayed++;
+		Batch.Moves += Moves.Num();
+
+		if (!bAgreed)
+		{
+			Batch.bMismatch = true;
+			Batch.Mismatch.Generator = Generator;
+			Batch.Mismatch.OriginalLength = Moves.Num();
+			Batch.Mismatch.Moves = Shrink(Target, Moves);
+			CheckGame(Target, Batch.Mismatch.Moves, &Batch.Mismatch.Description);
+			return;
+		}
+	}
+}
+
+bool FTicTacToeFuzzer::CheckGame(const FTicTacToeFuzzTarget& Target, const TArray<int32>& Moves, FString* OutDescription)
+{
+	FString Description;
+	bool bAgreed;
+	switch (Target.Mode)
+	{
+	case ETicTacToeGridMode::Ultimate:
+		bAgreed = ReplayGame<FUltimateChecker>(Target, Moves, Description);
+		break;
+	case ETicTacToeGridMode::Qubic:
+		bAgreed = ReplayGame<FQubicChecker>(Target, Moves, Description);
+		break;
+	default:
+		bAgreed = ReplayGame<FClassicChecker>(Target, Moves, Description);
+		break;
+	}
+
+	if (OutDescription != nullptr)
+	{
+		*OutDescription = Description;
+	}
+	return bAgreed;
+}
+
+TArray<int32> FTicTacToeFuzzer::Shrink(const FTicTacToeFuzzTarget& Target, const TArray<int32>& Moves)
+{
+	// Shortest prefix that disagrees, since nothing after the first disagreement matters
+	auto TrimToFirstMismatch = [&Target](TArray<int32>& InOutMoves)
+	{
+		TArray<int32> Prefix;
+		for (int32 Length = 0; Length <= InOutMoves.Num(); Length++)
+		{
+			if (!CheckGame(Target, Prefix))
+			{
+				InOutMoves = Prefix;
+				return;
+			}
+			if (Length < InOutMoves.Num())
+			{
+				Prefix.Add(InOutMoves[Length]);
+			}
+		}
+	};
+
+	TArray<int32> Best = Moves;
+	if (CheckGame(Target, Best))
+		return Best;
+
+	TrimToFirstMismatch(Best);
+
+	// Delete ever smaller runs of moves, keeping any deletion that still disagrees
+	bool bShrunk = true;
+	while (bShrunk)
+	{
+		bShrunk = false;
+		for (int32 Chunk = FMath::Max(1, Best.Num() / 2); Chunk >= 1; Chunk /= 2)
+		{
+			for (int32 Start = 0; Start + Chunk <= Best.Num(); )
+			{
+				TArray<int32> Candidate = Best;
+				Candidate.RemoveAt(Start, Chunk);
+				if (!CheckGame(Target, Candidate))
+				{
+					TrimToFirstMismatch(Candidate);
+					Best = Candidate;
+					bShrunk = true;
+				}
+				else
+				{
+					Start++;
+				}
+			}
+		}
+	}
+	return Best;
+}
+
+int32 FTicTacToeFuzzer::GetNumMismatches() const
+{
+	int32 NumMismatches = 0;
+	for (const FTicTacToeFuzzReport& Report : Reports)
+	{
+		NumMismatches += Report.Mismatches.Num();
+	}
+	return NumMismatches;
+}
+
+FString FTicTacToeFuzzer::FormatReport() const
+{
+	FString Result = FString::Printf(TEXT("%-28s %8s %12s %14s %10s\n"), TEXT("Target"), TEXT("Games"), TEXT("Moves"), TEXT("Moves/sec"), TEXT("Mismatches"));
+
+	int64 TotalMoves = 0;
+	double TotalSeconds = 0.0;
+	for (const FTicTacToeFuzzReport& Report : Reports)
+	{
+		Result += FString::Printf(TEXT("%-28s %8d %12lld %14.0f %10d\n"),
+			*Report.Target.ToString(), Report.Games, Report.Moves, Report.GetMovesPerSecond(), Report.Mismatches.Num());
+		TotalMoves += Report.Moves;
+		TotalSeconds += Report.Seconds;
+	}
+	Result += FString::Printf(TEXT("%-28s %8s %12lld %14.0f %10d\n"), TEXT("Total"), TEXT(""), TotalMoves, TotalSeconds > 0.0 ? TotalMoves / TotalSeconds : 0.0, GetNumMismatches());
+
+	for (const FTicTacToeFuzzReport& Report : Reports)
+	{
+		for (const FTicTacToeFuzzMismatch& Mismatch : Report.Mismatches)
+		{
+			FString MoveList;
+			for (int32 Move : Mismatch.Moves)
+			{
+				MoveList += FString::Printf(TEXT(" %d"), Move);
+			}
+			Result += FString::Printf(TEXT("\n%s, %s game shrunk from %d to %d moves:%s\n    %s\n"),
+				*Report.Target.ToString(), GetGeneratorName(Mismatch.Generator), Mismatch.OriginalLength, Mismatch.Moves.Num(), *MoveList, *Mismatch.Description);
+		}
+	}
+	return Result;
+}
@@ -0,0 +1,150 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToePosition.h"
+
+/** How the fuzzer picks each move of a game */
+enum class ETicTacToeFuzzGenerator : uint8
+{
+	/** Uniformly random legal move */
+	Random,
+	/** Win if possible, otherwise block, otherwise random, so games end on tactical lines */
+	Tactical,
+	/** Prefers cells on the board's edges, where line tables go wrong first */
+	EdgeBiased,
+	/** Avoids completing lines for as long as possible, filling the board towards draws */
+	Stalling,
+
+	Count
+};
+
+/** One rules variant to fuzz */
+struct TICTACTOE_API FTicTacToeFuzzTarget
+{
+	FTicTacToeFuzzTarget(ETicTacToeGridMode InMode = ETicTacToeGridMode::Classic, int32 InSize = 3, int32 InWinLength = 3)
+		: Mode(InMode)
+		, Size(InSize)
+		, WinLength(InWinLength)
+	{
+	}
+
+	ETicTacToeGridMode Mode;
+
+	/** Classic only */
+	int32 Size;
+	int32 WinLength;
+
+	FString ToString() const;
+};
+
+struct TICTACTOE_API FTicTacToeFuzzSettings
+{
+	FTicTacToeFuzzSettings()
+		: GamesPerTarget(20000)
+		, GamesPerBatch(500)
+		, Seed(0)
+	{
+	}
+
+	TArray<FTicTacToeFuzzTarget> Targets;
+
+	int32 GamesPerTarget;
+
+	/** Games run back to back on one worker. Each batch is seeded independently so results do not depend on the thread count. */
+	int32 GamesPerBatch;
+
+	/** Master seed, every game is reproducible from it */
+	int32 Seed;
+
+	/** Every Classic shape from 3x3 up to the largest board, plus Ultimate and Qubic */
+	static TArray<FTicTacToeFuzzTarget> GetAllTargets();
+};
+
+/** A game on which the optimized rules and the reference rules disagree */
+struct TICTACTOE_API FTicTacToeFuzzMismatch
+{
+	ETicTacToeFuzzGenerator Generator;
+
+	/** Shortest move list found that still shows a disagreement, in the board's own move encoding */
+	TArray<int32> Moves;
+
+	/** Length of the game before shrinking */
+	int32 OriginalLength;
+
+	/** What disagreed after the last move */
+	FString Description;
+};
+
+/** Results for one target */
+struct TICTACTOE_API FTicTacToeFuzzReport
+{
+	FTicTacToeFuzzReport() : Games(0), Moves(0), Seconds(0.0) { }
+
+	FTicTacToeFuzzTarget Target;
+
+	int32 Games;
+
+	/** Moves played and cross-checked */
+	int64 Moves;
+
+	/** Wall clock time for the target */
+	double Seconds;
+
+	/** At most one per batch, since a batch stops at its first mismatch */
+	TArray<FTicTacToeFuzzMismatch> Mismatches;
+
+	FORCEINLINE double GetMovesPerSecond() const { return Seconds > 0.0 ? Moves / Seconds : 0.0; }
+};
+
+/**
+ * Differential tester for the bitboard rules cores. Plays generated games on the optimized
+ * board and on a deliberately naive reference side by side, comparing legal moves, results
+ * and helper queries after every move, and shrinks any disagreement to a minimal move list.
+ */
+class TICTACTOE_API FTicTacToeFuzzer
+{
+public:
+	explicit FTicTacToeFuzzer(const FTicTacToeFuzzSettings& InSettings);
+
+	/** Fuzzes every target across all cores, blocking until done */
+	void Run();
+
+	/** Per target results, valid after Run */
+	FORCEINLINE const TArray<FTicTacToeFuzzReport>& GetReports() const { return Reports; }
+
+	/** Total mismatches over all targets */
+	int32 GetNumMismatches() const;
+
+	/** Human readable results table followed by every mismatch */
+	FString FormatReport() const;
+
+	/** Replays Moves on both implementations, returning true if they agree. Moves the reference rejects count as agreement. */
+	static bool CheckGame(const FTicTacToeFuzzTarget& Target, const TArray<int32>& Moves, FString* OutDescription = nullptr);
+
+	/** Removes moves from a disagreeing game for as long as it keeps disagreeing */
+	static TArray<int32> Shrink(const FTicTacToeFuzzTarget& Target, const TArray<int32>& Moves);
+
+private:
+
+	/** A run of consecutive games of one target */
+	struct FBatch
+	{
+		int32 TargetIndex;
+		int32 BatchIndex;
+		int32 NumGames;
+
+		/** Filled in by the worker */
+		int32 GamesPlayed;
+		int64 Moves;
+		bool bMismatch;
+		FTicTacToeFuzzMismatch Mismatch;
+	};
+
+	void RunBatch(FBatch& Batch) const;
+
+	FTicTacToeFuzzSettings Settings;
+
+	TArray<FTicTacToeFuzzReport> Reports;
+};
@@ -1,13 +1,95 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "TicTacToeGameMode.h"
+#include "TicTacToe.h"
 #include "TicTacToePlayerController.h"
 #include "TicTacToePawn.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+
+namespace
+{
+	/** Seconds between match server reports in the log */
+	constexpr double MatchReportInterval = 60.0;
+}
 
 ATicTacToeGameMode::ATicTacToeGameMode()
+	: LastReportTime(0.0)
+	, LastReportMatches(0)
 {
 	// no pawn by default
 	DefaultPawnClass = ATicTacToePawn::StaticClass();
 	// use our own player controller class
 	PlayerControllerClass = ATicTacToePlayerController::StaticClass();
+
+	// Only ticks while hosting the match server
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+}
+
+void ATicTacToeGameMode::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetNetMode() != NM_DedicatedServer)
+		return;
+
+	FTicTacToeMatchSettings Settings;
+	if (!FTicTacToeMatchSettings::Parse(FCommandLine::Get(), Settings))
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("Unknown -MatchMode, the match server is not started"));
+		return;
+	}
+
+	MatchServer = MakeUnique<FTicTacToeMatchServer>(Settings);
+	if (!MatchServer->Start())
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("Match server cannot listen on port %d"), Settings.Port);
+		MatchServer.Reset();
+		return;
+	}
+
+	UE_LOG(LogTicTacToe, Display, TEXT("Match server listening on port %d"), Settings.Port);
+	LastReportTime = FPlatformTime::Seconds();
+	SetActorTickEnabled(true);
+}
+
+void ATicTacToeGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	MatchServer.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ATicTacToeGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (!MatchServer.IsValid())
+		return;
+
+	// The engine's server tick rate paces the match server
+	MatchServer->Tick();
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastReportTime >= MatchReportInterval)
+	{
+		TArray<float> TickTimes;
+		MatchServer->ConsumeTickTimes(TickTimes);
+		float MaxTickTime = 0.f;
+		double TotalTickTime = 0.0;
+		for (float Time : TickTimes)
+		{
+			MaxTickTime = FMath::Max(MaxTickTime, Time);
+			TotalTickTime += Time;
+		}
+
+		const FTicTacToeMatchServerStats& Stats = MatchServer->GetStats();
+		UE_LOG(LogTicTacToe, Display, TEXT("Match server: %d clients, %d matches, %.1f matches/sec, tick mean %.3f ms max %.3f ms"),
+			Stats.Clients, Stats.ActiveMatches, (Stats.MatchesFinished - LastReportMatches) / (Now - LastReportTime),
+			TickTimes.Num() > 0 ? 1000.0 * TotalTickTime / TickTimes.Num() : 0.0, 1000.0 * MaxTickTime);
+
+		LastReportTime = Now;
+		LastReportMatches = Stats.MatchesFinished;
+	}
 }
@@ -4,9 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/GameModeBase.h"
+#include "TicTacToeMatchServer.h"
 #include "TicTacToeGameMode.generated.h"
 
-/** GameMode class to specify pawn and playercontroller */
+/** GameMode class to specify pawn and playercontroller, hosting the match server on a dedicated server */
 UCLASS(minimalapi)
 class ATicTacToeGameMode : public AGameModeBase
 {
@@ -14,6 +15,24 @@ class ATicTacToeGameMode : public AGameModeBase
 
 public:
 	ATicTacToeGameMode();
+
+protected:
+	// Begin AActor interface
+	virtual void BeginPlay() override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	virtual void Tick(float DeltaSeconds) override;
+	// End AActor interface
+
+private:
+
+	/** Referees bot and player matches when running as a dedicated server, null otherwise */
+	TUniquePtr<FTicTacToeMatchServer> MatchServer;
+
+	/** When the match server's counters were last logged, and its finished matches then */
+	double LastReportTime;
+	int64 LastReportMatches;
 };
 
 
@@ -0,0 +1,204 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeLoadTestCommandlet.h"
+#include "TicTacToe.h"
+#include "TicTacToeBotClients.h"
+#include "TicTacToeMatchServer.h"
+#include "Async/Async.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Templates/Atomic.h"
+
+namespace
+{
+	/** Seconds between progress lines */
+	constexpr double ReportInterval = 5.0;
+
+	/** Seconds between bot ticks when the bots run on the main thread */
+	constexpr double BotTickInterval = 0.001;
+
+	FString FormatTickTimes(TArray<float>& TickTimes)
+	{
+		if (TickTimes.Num() == 0)
+			return TEXT("no ticks");
+
+		TickTimes.Sort();
+		double Total = 0.0;
+		for (float Time : TickTimes)
+		{
+			Total += Time;
+		}
+		const float Percentile99 = TickTimes[FMath::Min(TickTimes.Num() - 1, TickTimes.Num() * 99 / 100)];
+		return FString::Printf(TEXT("tick mean %.3f ms  p99 %.3f ms  max %.3f ms"),
+			1000.0 * Total / TickTimes.Num(), 1000.0 * Percentile99, 1000.0 * TickTimes.Last());
+	}
+}
+
+UTicTacToeLoadTestCommandlet::UTicTacToeLoadTestCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTicTacToeLoadTestCommandlet::Main(const FString& Params)
+{
+	FTicTacToeBotSettings BotSettings;
+	if (!FTicTacToeMatchSettings::Parse(*Params, BotSettings.Match))
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("Unknown match mode"));
+		return 1;
+	}
+	FParse::Value(*Params, TEXT("Clients="), BotSettings.NumBots);
+	FParse::Value(*Params, TEXT("ThinkTime="), BotSettings.ThinkTime);
+	FParse::Value(*Params, TEXT("Host="), BotSettings.Host);
+	FParse::Value(*Params, TEXT("Seed="), BotSettings.Seed);
+	BotSettings.NumBots = FMath::Max(0, BotSettings.NumBots);
+
+	double Seconds = 60.0;
+	int32 TickRate = 30;
+	FParse::Value(*Params, TEXT("Seconds="), Seconds);
+	FParse::Value(*Params, TEXT("TickRate="), TickRate);
+
+	const bool bRunServer = !FParse::Param(*Params, TEXT("ClientsOnly"));
+	const bool bRunClients = !FParse::Param(*Params, TEXT("ServerOnly"));
+	if (!bRunServer && !bRunClients)
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("-ServerOnly and -ClientsOnly leave nothing to run"));
+		return 1;
+	}
+
+	const uint64 BaseMemory = FPlatformMemory::GetStats().UsedPhysical;
+	uint64 PeakMemory = BaseMemory;
+
+	FTicTacToeMatchServer Server(BotSettings.Match);
+	if (bRunServer && !Server.Start())
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("Cannot listen on port %d"), BotSettings.Match.Port);
+		return 1;
+	}
+
+	// Next to a server the bots get a thread of their own, as they would on client machines,
+	// and only the server's counters are read until the bots have stopped
+	FTicTacToeBotClients Bots(BotSettings);
+	TAtomic<bool> bStopBots(false);
+	TFuture<void> BotTask;
+	if (bRunServer && bRunClients)
+	{
+		BotTask = Async(EAsyncExecution::Thread, [&Bots, &bStopBots]()
+		{
+			Bots.Connect();
+			while (!bStopBots.Load(EMemoryOrder::Relaxed))
+			{
+				Bots.Tick();
+				FPlatformProcess::Sleep(float(BotTickInterval));
+			}
+			Bots.Disconnect();
+		});
+	}
+	else if (bRunClients && Bots.Connect() == 0)
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("No bot could connect to %s:%d"), *BotSettings.Host, BotSettings.Match.Port);
+		return 1;
+	}
+
+	TArray<FString> Parts;
+	if (bRunServer)
+	{
+		Parts.Add(FString::Printf(TEXT("server ticking at %d Hz"), TickRate));
+	}
+	if (bRunClients)
+	{
+		Parts.Add(FString::Printf(TEXT("%d bots thinking %.2f s"), BotSettings.NumBots, BotSettings.ThinkTime));
+	}
+	UE_LOG(LogTicTacToe, Display, TEXT("Load test for %.0f s on port %d: %s"), Seconds, BotSettings.Match.Port, *FString::Join(Parts, TEXT(" and ")));
+
+	// Zero tick rate ticks the server as fast as it can go
+	const double TickInterval = bRunServer ? (TickRate > 0 ? 1.0 / TickRate : 0.0) : BotTickInterval;
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = StartTime + Seconds;
+	double NextTick = StartTime;
+	double ReportTime = StartTime;
+	int64 ReportMatches = 0;
+	TArray<float> TickTimes;
+	TArray<float> AllTickTimes;
+	while (FPlatformTime::Seconds() < EndTime)
+	{
+		if (bRunServer)
+		{
+			Server.Tick();
+		}
+		else
+		{
+			Bots.Tick();
+		}
+
+		// A late tick is not made up for
+		NextTick += TickInterval;
+		const double Wait = NextTick - FPlatformTime::Seconds();
+		if (Wait > 0.0)
+		{
+			FPlatformProcess::Sleep(float(Wait));
+		}
+		else
+		{
+			NextTick = FPlatformTime::Seconds();
+		}
+
+		const double Now = FPlatformTime::Seconds();
+		if (Now - ReportTime < ReportInterval)
+			continue;
+
+		PeakMemory = FMath::Max(PeakMemory, FPlatformMemory::GetStats().UsedPhysical);
+		const int64 Matches = bRunServer ? Server.GetStats().MatchesFinished : Bots.GetStats().MatchesPlayed;
+		if (bRunServer)
+		{
+			Server.ConsumeTickTimes(TickTimes);
+			UE_LOG(LogTicTacToe, Display, TEXT("%6.0f s  %5d clients  %5d matches  %8.1f matches/sec  %s"),
+				Now - StartTime, Server.GetStats().Clients, Server.GetStats().ActiveMatches, (Matches - ReportMatches) / (Now - ReportTime), *FormatTickTimes(TickTimes));
+			AllTickTimes.Append(TickTimes);
+			TickTimes.Reset();
+		}
+		else
+		{
+			UE_LOG(LogTicTacToe, Display, TEXT("%6.0f s  %5d bots connected  %8.1f games/sec"),
+				Now - StartTime, Bots.GetStats().Connected, (Matches - ReportMatches) / (Now - ReportTime));
+		}
+		ReportTime = Now;
+		ReportMatches = Matches;
+	}
+
+	const double Elapsed = FPlatformTime::Seconds() - StartTime;
+	bStopBots.Store(true);
+	if (BotTask.IsValid())
+	{
+		BotTask.Wait();
+	}
+	else
+	{
+		Bots.Disconnect();
+	}
+
+	if (bRunServer)
+	{
+		PeakMemory = FMath::Max(PeakMemory, FPlatformMemory::GetStats().UsedPhysical);
+		Server.ConsumeTickTimes(AllTickTimes);
+		const FTicTacToeMatchServerStats& Stats = Server.GetStats();
+		const double MemoryPerMatch = Stats.PeakMatches > 0 ? double(PeakMemory - FMath::Min(PeakMemory, BaseMemory)) / Stats.PeakMatches : 0.0;
+
+		UE_LOG(LogTicTacToe, Display, TEXT("%lld matches in %.1f s: %.1f matches/sec, %lld moves, %lld forfeits"),
+			Stats.MatchesFinished, Elapsed, Stats.MatchesFinished / Elapsed, Stats.Moves, Stats.Forfeits);
+		UE_LOG(LogTicTacToe, Display, TEXT("%lld ticks, %s"), Stats.Ticks, *FormatTickTimes(AllTickTimes));
+		UE_LOG(LogTicTacToe, Display, TEXT("Memory: %d bytes of server state per match, %.1f KB of process memory per concurrent match at a peak of %d%s"),
+			FTicTacToeMatchServer::GetBytesPerMatch(), MemoryPerMatch / 1024.0, Stats.PeakMatches, bRunClients ? TEXT(", bots included") : TEXT(""));
+	}
+	if (bRunClients)
+	{
+		UE_LOG(LogTicTacToe, Display, TEXT("Bots finished %lld games, %d disconnects"), Bots.GetStats().MatchesPlayed, Bots.GetStats().Disconnects);
+	}
+
+	Server.Stop();
+	return 0;
+}
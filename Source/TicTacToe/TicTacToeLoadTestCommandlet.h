@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TicTacToeLoadTestCommandlet.generated.h"
+
+/**
+ * Load tests the match server with headless bot clients and logs matches per second, server tick
+ * times and memory per match. By default the server and the bots run in this process and talk over
+ * loopback. -ServerOnly runs just the server for bots on other machines, -ClientsOnly runs just the
+ * bots against -Host, for example a TicTacToeServer build.
+ *
+ * UE4Editor-Cmd TicTacToe -run=TicTacToeLoadTest [-Clients=200] [-Seconds=60] [-TickRate=30]
+ *     [-ThinkTime=0] [-MatchPort=7780] [-MatchMode=Classic] [-MatchSize=3] [-Seed=0]
+ *     [-ServerOnly | -ClientsOnly -Host=127.0.0.1]
+ */
+UCLASS()
+class UTicTacToeLoadTestCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTicTacToeLoadTestCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
@@ -0,0 +1,322 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeMatchServer.h"
+#include "Common/TcpSocketBuilder.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+namespace
+{
+	/** Connections the operating system may hold before they are accepted */
+	constexpr int32 ListenBacklog = 512;
+
+	void DestroySocket(FSocket* Socket)
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+	}
+
+	ETicTacToeResult GetWinFor(int32 Side)
+	{
+		return Side == 0 ? ETicTacToeResult::Player1Win : ETicTacToeResult::Player2Win;
+	}
+}
+
+bool FTicTacToeMatchSettings::Parse(const TCHAR* CommandLine, FTicTacToeMatchSettings& OutSettings)
+{
+	FParse::Value(CommandLine, TEXT("MatchPort="), OutSettings.Port);
+	FParse::Value(CommandLine, TEXT("MatchSize="), OutSettings.Size);
+	OutSettings.Size = FMath::Clamp(OutSettings.Size, 3, FTicTacToeLineTable::MaxSize);
+
+	FString ModeName;
+	if (FParse::Value(CommandLine, TEXT("MatchMode="), ModeName))
+	{
+		if (ModeName == TEXT("Classic"))
+		{
+			OutSettings.Mode = ETicTacToeGridMode::Classic;
+		}
+		else if (ModeName == TEXT("Ultimate"))
+		{
+			OutSettings.Mode = ETicTacToeGridMode::Ultimate;
+		}
+		else if (ModeName == TEXT("Qubic"))
+		{
+			OutSettings.Mode = ETicTacToeGridMode::Qubic;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+FTicTacToeMatchServer::FTicTacToeMatchServer(const FTicTacToeMatchSettings& InSettings)
+	: Settings(InSettings)
+	, Listener(nullptr)
+{
+}
+
+FTicTacToeMatchServer::~FTicTacToeMatchServer()
+{
+	Stop();
+}
+
+bool FTicTacToeMatchServer::Start()
+{
+	if (Listener != nullptr)
+		return true;
+
+	Listener = FTcpSocketBuilder(TEXT("TicTacToeMatchServer"))
+		.AsNonBlocking()
+		.AsReusable()
+		.BoundToEndpoint(FIPv4Endpoint(FIPv4Address::Any, Settings.Port))
+		.Listening(ListenBacklog)
+		.Build();
+
+	return Listener != nullptr;
+}
+
+void FTicTacToeMatchServer::Stop()
+{
+	for (const TUniquePtr<FConnection>& Connection : Connections)
+	{
+		DestroySocket(Connection->Socket);
+	}
+	Connections.Reset();
+	Matches.Reset();
+	Queue.Reset();
+	Stats.Clients = 0;
+	Stats.ActiveMatches = 0;
+
+	if (Listener != nullptr)
+	{
+		DestroySocket(Listener);
+		Listener = nullptr;
+	}
+}
+
+void FTicTacToeMatchServer::Tick()
+{
+	if (Listener == nullptr)
+		return;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	AcceptConnections();
+	for (const TUniquePtr<FConnection>& Connection : Connections)
+	{
+		ReadMessages(*Connection);
+	}
+	StartMatches();
+	for (const TUniquePtr<FConnection>& Connection : Connections)
+	{
+		Flush(*Connection);
+	}
+	RemoveFinished();
+
+	Stats.Ticks++;
+	TickTimes.Add(float(FPlatformTime::Seconds() - StartTime));
+}
+
+void FTicTacToeMatchServer::ConsumeTickTimes(TArray<float>& OutTickTimes)
+{
+	OutTickTimes.Append(TickTimes);
+	TickTimes.Reset();
+}
+
+int32 FTicTacToeMatchServer::GetBytesPerMatch()
+{
+	return sizeof(FMatch) + sizeof(TUniquePtr<FMatch>) + 2 * (sizeof(FConnection) + sizeof(TUniquePtr<FConnection>));
+}
+
+void FTicTacToeMatchServer::AcceptConnections()
+{
+	bool bPending = false;
+	while (Listener->HasPendingConnection(bPending) && bPending)
+	{
+		FSocket* Socket = Listener->Accept(TEXT("TicTacToeMatchClient"));
+		if (Socket == nullptr)
+			break;
+
+		Socket->SetNonBlocking(true);
+		Socket->SetNoDelay(true);
+		Connections.Add(MakeUnique<FConnection>(Socket));
+	}
+	Stats.Clients = Connections.Num();
+}
+
+void FTicTacToeMatchServer::ReadMessages(FConnection& Connection)
+{
+	uint8 Buffer[256];
+	while (!Connection.bClosed)
+	{
+		// Fails once the client has gone, succeeds with nothing read when there is nothing to read
+		int32 BytesRead = 0;
+		if (!Connection.Socket->Recv(Buffer, sizeof(Buffer), BytesRead))
+		{
+			Connection.bClosed = true;
+			break;
+		}
+		if (BytesRead == 0)
+			break;
+
+		for (int32 Index = 0; Index < BytesRead && !Connection.bClosed; Index++)
+		{
+			Connection.Partial[Connection.NumPartial++] = Buffer[Index];
+			if (Connection.NumPartial == 2)
+			{
+				Connection.NumPartial = 0;
+				HandleMessage(Connection, ETicTacToeMatchMessage(Connection.Partial[0]), Connection.Partial[1]);
+			}
+		}
+	}
+}
+
+void FTicTacToeMatchServer::HandleMessage(FConnection& Connection, ETicTacToeMatchMessage Type, uint8 Argument)
+{
+	switch (Type)
+	{
+	case ETicTacToeMatchMessage::Join:
+		if (Connection.Match == nullptr && !Connection.bQueued)
+		{
+			Connection.bQueued = true;
+			Queue.Add(&Connection);
+		}
+		break;
+
+	case ETicTacToeMatchMessage::Move:
+	{
+		// A late move after a forfeit is harmless
+		FMatch* Match = Connection.Match;
+		if (Match == nullptr)
+			break;
+
+		if (Match->Position.GetSideToMove() != Connection.Side || !Match->Position.IsLegal(Argument))
+		{
+			Stats.Forfeits++;
+			EndMatch(*Match, GetWinFor(1 - Connection.Side));
+			break;
+		}
+
+		Match->Position.MakeMove(Argument);
+		Stats.Moves++;
+		Send(*Match->Players[1 - Connection.Side], ETicTacToeMatchMessage::Moved, Argument);
+		if (Match->Position.IsGameOver())
+		{
+			EndMatch(*Match, Match->Position.GetResult());
+		}
+		break;
+	}
+
+	default:
+		// Only the server sends the other messages
+		Connection.bClosed = true;
+		break;
+	}
+}
+
+void FTicTacToeMatchServer::StartMatches()
+{
+	// Players that dropped during this tick's reads would forfeit at once, inventing matches
+	Queue.RemoveAll([](FConnection* Player)
+	{
+		if (!Player->bClosed)
+			return false;
+
+		Player->bQueued = false;
+		return true;
+	});
+
+	int32 NumPaired = 0;
+	for (; NumPaired + 1 < Queue.Num(); NumPaired += 2)
+	{
+		FConnection* Players[2] = { Queue[NumPaired], Queue[NumPaired + 1] };
+		TUniquePtr<FMatch> Match = MakeUnique<FMatch>(FTicTacToePosition(Settings.Mode, Settings.Size), Players[0], Players[1]);
+		for (int32 Side = 0; Side < 2; Side++)
+		{
+			Players[Side]->bQueued = false;
+			Players[Side]->Match = Match.Get();
+			Players[Side]->Side = Side;
+			Send(*Players[Side], ETicTacToeMatchMessage::Start, uint8(Side));
+		}
+		Matches.Add(MoveTemp(Match));
+
+		Stats.MatchesStarted++;
+		Stats.ActiveMatches++;
+		Stats.PeakMatches = FMath::Max(Stats.PeakMatches, Stats.ActiveMatches);
+	}
+	Queue.RemoveAt(0, NumPaired);
+}
+
+void FTicTacToeMatchServer::EndMatch(FMatch& Match, ETicTacToeResult Result)
+{
+	for (FConnection* Player : Match.Players)
+	{
+		Send(*Player, ETicTacToeMatchMessage::End, uint8(Result));
+		Player->Match = nullptr;
+	}
+	Match.bFinished = true;
+
+	Stats.MatchesFinished++;
+	Stats.ActiveMatches--;
+}
+
+void FTicTacToeMatchServer::Send(FConnection& Connection, ETicTacToeMatchMessage Type, uint8 Argument)
+{
+	if (!Connection.bClosed)
+	{
+		Connection.Outgoing.Add(uint8(Type));
+		Connection.Outgoing.Add(Argument);
+	}
+}
+
+void FTicTacToeMatchServer::Flush(FConnection& Connection)
+{
+	if (Connection.bClosed || Connection.Outgoing.Num() == 0)
+		return;
+
+	// A full send buffer keeps the rest for the next tick
+	int32 BytesSent = 0;
+	if (Connection.Socket->Send(Connection.Outgoing.GetData(), Connection.Outgoing.Num(), BytesSent))
+	{
+		Connection.Outgoing.RemoveAt(0, BytesSent, false);
+	}
+	else if (ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() != SE_EWOULDBLOCK)
+	{
+		Connection.bClosed = true;
+	}
+}
+
+void FTicTacToeMatchServer::RemoveFinished()
+{
+	for (const TUniquePtr<FConnection>& Connection : Connections)
+	{
+		if (!Connection->bClosed)
+			continue;
+
+		// Leaving a match concedes it, the opponent hears of it on the next flush
+		if (Connection->Match != nullptr)
+		{
+			Stats.Forfeits++;
+			EndMatch(*Connection->Match, GetWinFor(1 - Connection->Side));
+		}
+		if (Connection->bQueued)
+		{
+			Queue.Remove(Connection.Get());
+		}
+		DestroySocket(Connection->Socket);
+	}
+
+	Connections.RemoveAll([](const TUniquePtr<FConnection>& Connection)
+	{
+		return Connection->bClosed;
+	});
+	Matches.RemoveAllSwap([](const TUniquePtr<FMatch>& Match)
+	{
+		return Match->bFinished;
+	});
+	Stats.Clients = Connections.Num();
+}
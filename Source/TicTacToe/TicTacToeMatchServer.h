@@ -0,0 +1,186 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToePosition.h"
+
+class FSocket;
+
+/** Messages of the match protocol. Every message is two bytes, its type followed by one argument byte. */
+enum class ETicTacToeMatchMessage : uint8
+{
+	/** Client to server: queue me for the next match */
+	Join,
+	/** Client to server: claim a block, the argument is its block index */
+	Move,
+	/** Server to client: a match started, the argument is the side you play, 0 moving first */
+	Start,
+	/** Server to client: the opponent claimed a block, the argument is its block index */
+	Moved,
+	/** Server to client: the match is over, the argument is the ETicTacToeResult */
+	End,
+
+	Count
+};
+
+/** Configuration shared by the match server and the clients that play on it */
+struct TICTACTOE_API FTicTacToeMatchSettings
+{
+	FTicTacToeMatchSettings()
+		: Port(7780)
+		, Mode(ETicTacToeGridMode::Classic)
+		, Size(3)
+	{
+	}
+
+	/** TCP port the server listens on */
+	int32 Port;
+
+	/** Rules of every match */
+	ETicTacToeGridMode Mode;
+
+	/** Classic grid size */
+	int32 Size;
+
+	/** Reads -MatchPort=, -MatchMode=Classic|Ultimate|Qubic and -MatchSize= over the defaults, returning false on an unknown mode */
+	static bool Parse(const TCHAR* CommandLine, FTicTacToeMatchSettings& OutSettings);
+};
+
+/** Counters of a match server since it started */
+struct TICTACTOE_API FTicTacToeMatchServerStats
+{
+	FTicTacToeMatchServerStats()
+		: Clients(0)
+		, ActiveMatches(0)
+		, PeakMatches(0)
+		, MatchesStarted(0)
+		, MatchesFinished(0)
+		, Forfeits(0)
+		, Moves(0)
+		, Ticks(0)
+	{
+	}
+
+	/** Connected right now */
+	int32 Clients;
+	int32 ActiveMatches;
+
+	/** Most matches in progress at once */
+	int32 PeakMatches;
+
+	int64 MatchesStarted;
+	int64 MatchesFinished;
+
+	/** Matches ended by an illegal move or a disconnect */
+	int64 Forfeits;
+
+	int64 Moves;
+	int64 Ticks;
+};
+
+/**
+ * Headless server that pairs clients as they queue and referees their matches over a small TCP
+ * protocol, using the same rules cores as the grid. Everything happens in Tick on the calling
+ * thread with non-blocking sockets, so one server hosts thousands of concurrent matches at a
+ * fixed tick rate and the cost of each tick can be measured for capacity planning.
+ */
+class TICTACTOE_API FTicTacToeMatchServer
+{
+public:
+	explicit FTicTacToeMatchServer(const FTicTacToeMatchSettings& InSettings);
+	~FTicTacToeMatchServer();
+
+	/** Opens the listening socket, returning false if the port could not be bound */
+	bool Start();
+
+	/** Disconnects every client and closes the listening socket */
+	void Stop();
+
+	FORCEINLINE bool IsRunning() const { return Listener != nullptr; }
+
+	/** Accepts connections, reads every client's messages, starts and referees matches and sends the replies */
+	void Tick();
+
+	FORCEINLINE const FTicTacToeMatchServerStats& GetStats() const { return Stats; }
+
+	/** Moves the duration in seconds of every tick since the last call into OutTickTimes */
+	void ConsumeTickTimes(TArray<float>& OutTickTimes);
+
+	/** Server memory one match holds, its two connections included, not counting socket buffers */
+	static int32 GetBytesPerMatch();
+
+private:
+
+	struct FMatch;
+
+	struct FConnection
+	{
+		explicit FConnection(FSocket* InSocket)
+			: Socket(InSocket)
+			, NumPartial(0)
+			, Match(nullptr)
+			, Side(0)
+			, bQueued(false)
+			, bClosed(false)
+		{
+		}
+
+		FSocket* Socket;
+
+		/** Bytes of an incomplete message */
+		uint8 Partial[2];
+		int32 NumPartial;
+
+		/** Replies not yet accepted by the socket */
+		TArray<uint8> Outgoing;
+
+		/** Match being played, null when idle or queued */
+		FMatch* Match;
+		int32 Side;
+
+		bool bQueued;
+
+		/** Set when the socket fails, the connection is removed at the end of the tick */
+		bool bClosed;
+	};
+
+	struct FMatch
+	{
+		FMatch(const FTicTacToePosition& InPosition, FConnection* First, FConnection* Second)
+			: Position(InPosition)
+			, bFinished(false)
+		{
+			Players[0] = First;
+			Players[1] = Second;
+		}
+
+		FTicTacToePosition Position;
+		FConnection* Players[2];
+		bool bFinished;
+	};
+
+	void AcceptConnections();
+	void ReadMessages(FConnection& Connection);
+	void HandleMessage(FConnection& Connection, ETicTacToeMatchMessage Type, uint8 Argument);
+	void StartMatches();
+	void EndMatch(FMatch& Match, ETicTacToeResult Result);
+	void Send(FConnection& Connection, ETicTacToeMatchMessage Type, uint8 Argument);
+	void Flush(FConnection& Connection);
+
+	/** Frees closed connections and finished matches */
+	void RemoveFinished();
+
+	FTicTacToeMatchSettings Settings;
+
+	FSocket* Listener;
+
+	TArray<TUniquePtr<FConnection>> Connections;
+	TArray<TUniquePtr<FMatch>> Matches;
+
+	/** Connections waiting for an opponent, longest waiting first */
+	TArray<FConnection*> Queue;
+
+	FTicTacToeMatchServerStats Stats;
+	TArray<float> TickTimes;
+};
@@ -0,0 +1,389 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeNTupleNetwork.h"
+#include "TicTacToeAI.h"
+#include "TicTacToeSymmetry.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	/** "NTTT" */
+	constexpr uint32 FileMagic = 0x5454544E;
+	constexpr uint16 FileVersion = 1;
+
+	float GetResultValue(ETicTacToeResult Result)
+	{
+		switch (Result)
+		{
+		case ETicTacToeResult::Player1Win:
+			return 1.f;
+		case ETicTacToeResult::Player2Win:
+			return -1.f;
+		default:
+			return 0.f;
+		}
+	}
+
+	/** Cells of a line in increasing index order, which runs along the line */
+	void GetLineCells(uint64 Line, TArray<int32, TInlineAllocator<8>>& OutCells)
+	{
+		for (; Line; Line &= Line - 1)
+		{
+			OutCells.Add(FMath::CountTrailingZeros64(Line));
+		}
+	}
+}
+
+FTicTacToeNTupleNetwork::FTicTacToeNTupleNetwork(int32 InSize, int32 InWinLength)
+	: Size(InSize)
+	, WinLength(InWinLength)
+{
+	const FTicTacToeLineTable& Lines = FTicTacToeLineTable::Get(Size, WinLength);
+	const FTicTacToeSymmetry& Symmetry = FTicTacToeSymmetry::Get(Size);
+	const int32 NumWindows = Lines.Lines.Num();
+
+	int32 Powers[FTicTacToeLineTable::MaxSize];
+	TableSize = 1;
+	for (int32 Position = 0; Position < WinLength; Position++)
+	{
+		Powers[Position] = TableSize;
+		TableSize *= 3;
+	}
+
+	// Windows a symmetry maps onto each other share a table. An image may run the other way
+	// along its line, in which case its cells take the place values in reverse.
+	TArray<int32> Places;
+	Places.SetNumZeroed(NumWindows * WinLength);
+	WindowTables.Init(INDEX_NONE, NumWindows);
+	int32 NumTables = 0;
+	for (int32 Window = 0; Window < NumWindows; Window++)
+	{
+		if (WindowTables[Window] != INDEX_NONE)
+			continue;
+
+		const int32 Table = NumTables++ * TableSize;
+		TArray<int32, TInlineAllocator<8>> Cells;
+		GetLineCells(Lines.Lines[Window], Cells);
+
+		for (int32 Transform = 0; Transform < FTicTacToeSymmetry::NumTransforms; Transform++)
+		{
+			const uint64 Image = Symmetry.TransformMask(Lines.Lines[Window], ETicTacToeSymmetry(Transform));
+			const int32 ImageWindow = Lines.Lines.IndexOfByKey(Image);
+			if (ImageWindow == INDEX_NONE || WindowTables[ImageWindow] != INDEX_NONE)
+				continue;
+
+			TArray<int32, TInlineAllocator<8>> ImageCells;
+			GetLineCells(Image, ImageCells);
+			const bool bReversed = Symmetry.TransformCell(Cells[0], ETicTacToeSymmetry(Transform)) != ImageCells[0];
+
+			WindowTables[ImageWindow] = Table;
+			for (int32 Position = 0; Position < WinLength; Position++)
+			{
+				Places[ImageWindow * WinLength + Position] = Powers[bReversed ? WinLength - 1 - Position : Position];
+			}
+		}
+	}
+	BankSize = NumTables * TableSize;
+	Weights.SetNumZeroed(2 * BankSize);
+
+	// Bucket the windows by the cells they cover
+	const int32 NumCells = Size * Size;
+	CellWindowStart.SetNumZeroed(NumCells + 1);
+	for (int32 Cell = 0; Cell < NumCells; Cell++)
+	{
+		CellWindowStart[Cell] = CellWindows.Num();
+		for (int32 Window = 0; Window < NumWindows; Window++)
+		{
+			const uint64 Line = Lines.Lines[Window];
+			if ((Line >> Cell) & 1)
+			{
+				// Position of the cell along the window
+				const int32 Position = FMath::CountBits(Line & ((1ull << Cell) - 1));
+				CellWindows.Add({ Window, Places[Window * WinLength + Position] });
+			}
+		}
+	}
+	CellWindowStart[NumCells] = CellWindows.Num();
+}
+
+float FTicTacToeNTupleNetwork::Evaluate(const FTicTacToeBoard& Board) const
+{
+	FTicTacToeNTupleState State(*this);
+	State.SetPosition(Board);
+	return State.GetValue();
+}
+
+bool FTicTacToeNTupleNetwork::Save(const FString& Path) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	// One scale for the whole file keeps every weight within 16 bits
+	float MaxWeight = 0.f;
+	for (float Weight : Weights)
+	{
+		MaxWeight = FMath::Max(MaxWeight, FMath::Abs(Weight));
+	}
+	float Scale = MaxWeight > 0.f ? MaxWeight / MAX_int16 : 1.f;
+
+	uint32 Magic = FileMagic;
+	uint16 Version = FileVersion;
+	uint8 FileSize = uint8(Size);
+	uint8 FileWinLength = uint8(WinLength);
+	int32 NumWeights = Weights.Num();
+	Writer << Magic << Version << FileSize << FileWinLength << NumWeights << Scale;
+
+	for (float Weight : Weights)
+	{
+		int16 Quantized = int16(FMath::RoundToInt(Weight / Scale));
+		Writer << Quantized;
+	}
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+TUniquePtr<FTicTacToeNTupleNetwork> FTicTacToeNTupleNetwork::Load(const FString& Path)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+		return nullptr;
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	uint8 FileSize = 0;
+	uint8 FileWinLength = 0;
+	int32 NumWeights = 0;
+	float Scale = 0.f;
+	Reader << Magic << Version << FileSize << FileWinLength << NumWeights << Scale;
+
+	if (Reader.IsError() || Magic != FileMagic || Version != FileVersion
+		|| FileSize < 3 || FileSize > FTicTacToeLineTable::MaxSize || FileWinLength < 3 || FileWinLength > FileSize)
+		return nullptr;
+
+	TUniquePtr<FTicTacToeNTupleNetwork> Network = MakeUnique<FTicTacToeNTupleNetwork>(FileSize, FileWinLength);
+	if (NumWeights != Network->Weights.Num())
+		return nullptr;
+
+	for (float& Weight : Network->Weights)
+	{
+		int16 Quantized = 0;
+		Reader << Quantized;
+		Weight = Quantized * Scale;
+	}
+
+	if (Reader.IsError())
+		return nullptr;
+
+	return Network;
+}
+
+FString FTicTacToeNTupleNetwork::GetDefaultPath(int32 Size, int32 WinLength)
+{
+	return FPaths::ProjectContentDir() / TEXT("AI") / FString::Printf(TEXT("NTuple_%dx%d_%d.bin"), Size, Size, WinLength);
+}
+
+const FTicTacToeNTupleNetwork* FTicTacToeNTupleNetwork::FindTrained(int32 Size, int32 WinLength)
+{
+	static FCriticalSection Mutex;
+	static TMap<int32, TUniquePtr<FTicTacToeNTupleNetwork>> Networks;
+
+	FScopeLock Lock(&Mutex);
+
+	// Shapes without a file are remembered too, so the disk is only checked once
+	const int32 Key = Size * (FTicTacToeLineTable::MaxSize + 1) + WinLength;
+	TUniquePtr<FTicTacToeNTupleNetwork>* Found = Networks.Find(Key);
+	if (Found == nullptr)
+	{
+		// A file copied under another shape's name would index past this shape's cells
+		TUniquePtr<FTicTacToeNTupleNetwork> Network = Load(GetDefaultPath(Size, WinLength));
+		if (Network.IsValid() && (Network->GetSize() != Size || Network->GetWinLength() != WinLength))
+		{
+			Network.Reset();
+		}
+		Found = &Networks.Add(Key, MoveTemp(Network));
+	}
+	return Found->Get();
+}
+
+FTicTacToeNTupleState::FTicTacToeNTupleState(const FTicTacToeNTupleNetwork& InNetwork)
+	: Network(InNetwork)
+{
+	Reset();
+}
+
+void FTicTacToeNTupleState::Reset()
+{
+	Indices = Network.WindowTables;
+	SideToMove = 0;
+	Refresh();
+}
+
+void FTicTacToeNTupleState::SetPosition(const FTicTacToeBoard& Board)
+{
+	Reset();
+	for (int32 Player = 0; Player < 2; Player++)
+	{
+		for (uint64 Marks = Board.Marks[Player]; Marks; Marks &= Marks - 1)
+		{
+			MakeMove(FMath::CountTrailingZeros64(Marks), Player);
+		}
+	}
+	SideToMove = Board.GetSideToMove();
+}
+
+void FTicTacToeNTupleState::MakeMove(int32 Cell, int32 Player)
+{
+	const TArray<float>& Weights = Network.Weights;
+	for (int32 Index = Network.CellWindowStart[Cell]; Index < Network.CellWindowStart[Cell + 1]; Index++)
+	{
+		const FTicTacToeNTupleNetwork::FCellWindow& CellWindow = Network.CellWindows[Index];
+		int32& WeightIndex = Indices[CellWindow.Window];
+		Sums[0] -= Weights[WeightIndex];
+		Sums[1] -= Weights[WeightIndex + Network.BankSize];
+		WeightIndex += (Player + 1) * CellWindow.Place;
+		Sums[0] += Weights[WeightIndex];
+		Sums[1] += Weights[WeightIndex + Network.BankSize];
+	}
+	SideToMove = 1 - Player;
+}
+
+void FTicTacToeNTupleState::UndoMove(int32 Cell, int32 Player)
+{
+	const TArray<float>& Weights = Network.Weights;
+	for (int32 Index = Network.CellWindowStart[Cell]; Index < Network.CellWindowStart[Cell + 1]; Index++)
+	{
+		const FTicTacToeNTupleNetwork::FCellWindow& CellWindow = Network.CellWindows[Index];
+		int32& WeightIndex = Indices[CellWindow.Window];
+		Sums[0] -= Weights[WeightIndex];
+		Sums[1] -= Weights[WeightIndex + Network.BankSize];
+		WeightIndex -= (Player + 1) * CellWindow.Place;
+		Sums[0] += Weights[WeightIndex];
+		Sums[1] += Weights[WeightIndex + Network.BankSize];
+	}
+	SideToMove = Player;
+}
+
+float FTicTacToeNTupleState::GetValue(int32 Side) const
+{
+	// tanh, written with Exp
+	return 1.f - 2.f / (FMath::Exp(2.f * FMath::Clamp(Sums[Side], -20.f, 20.f)) + 1.f);
+}
+
+void FTicTacToeNTupleState::Refresh()
+{
+	Sums[0] = Sums[1] = 0.f;
+	for (int32 WeightIndex : Indices)
+	{
+		Sums[0] += Network.Weights[WeightIndex];
+		Sums[1] += Network.Weights[WeightIndex + Network.BankSize];
+	}
+}
+
+FTicTacToeNTupleTrainer::FTicTacToeNTupleTrainer(FTicTacToeNTupleNetwork& InNetwork, const FTicTacToeNTupleTrainingSettings& InSettings)
+	: Network(InNetwork)
+	, Settings(InSettings)
+	, Random(InSettings.Seed)
+	, GamesPlayed(0)
+{
+	Results[0] = Results[1] = Results[2] = 0;
+}
+
+void FTicTacToeNTupleTrainer::Train(int32 Count)
+{
+	for (int32 Game = 0; Game < Count; Game++)
+	{
+		PlayGame();
+		GamesPlayed++;
+	}
+}
+
+void FTicTacToeNTupleTrainer::ConsumeResults(int32& OutWins, int32& OutDraws, int32& OutLosses)
+{
+	OutWins = Results[0];
+	OutDraws = Results[1];
+	OutLosses = Results[2];
+	Results[0] = Results[1] = Results[2] = 0;
+}
+
+void FTicTacToeNTupleTrainer::PlayGame()
+{
+	FTicTacToeBoard Board(Network.Size, Network.WinLength);
+	FTicTacToeNTupleState State(Network);
+	FTicTacToeNTupleState Previous(Network);
+	bool bHasPrevious = false;
+
+	const float Progress = Settings.Games > 0 ? FMath::Min(1.f, float(GamesPlayed) / Settings.Games) : 1.f;
+	const float Exploration = Settings.Exploration * (1.f - 0.9f * Progress);
+
+	while (!Board.IsGameOver())
+	{
+		const int32 Side = Board.GetSideToMove();
+
+		// Immediate wins are taken outright, otherwise the best afterstate or an exploratory move
+		int32 Cell = FTicTacToeEngine::FindWinningCell(Board, Side);
+		if (Cell == INDEX_NONE)
+		{
+			const uint64 Empty = Board.GetEmptyMask();
+			if (Random.GetFraction() < Exploration)
+			{
+				Cell = FTicTacToeEngine::RandomCell(Empty, Random);
+			}
+			else
+			{
+				float BestValue = -2.f;
+				for (uint64 Moves = Empty; Moves; Moves &= Moves - 1)
+				{
+					const int32 Candidate = FMath::CountTrailingZeros64(Moves);
+					State.MakeMove(Candidate, Side);
+					const float Value = Side == 0 ? State.GetValue() : -State.GetValue();
+					State.UndoMove(Candidate, Side);
+
+					if (Value > BestValue)
+					{
+						BestValue = Value;
+						Cell = Candidate;
+					}
+				}
+			}
+		}
+
+		Board.MakeMove(Cell);
+		State.MakeMove(Cell, Side);
+
+		// TD(0): the previous afterstate learns from this one, or from the result once the game is over
+		const float Target = Board.IsGameOver() ? GetResultValue(Board.Result) : State.GetValue();
+		if (bHasPrevious)
+		{
+			Update(Previous, Target);
+		}
+		if (Board.IsGameOver())
+		{
+			Update(State, Target);
+		}
+		State.Refresh();
+
+		Previous.Indices = State.Indices;
+		Previous.Sums[0] = State.Sums[0];
+		Previous.Sums[1] = State.Sums[1];
+		Previous.SideToMove = State.SideToMove;
+		bHasPrevious = true;
+	}
+
+	Results[Board.Result == ETicTacToeResult::Player1Win ? 0 : (Board.Result == ETicTacToeResult::Draw ? 1 : 2)]++;
+}
+
+void FTicTacToeNTupleTrainer::Update(const FTicTacToeNTupleState& State, float Target)
+{
+	// Gradient of the squared error through tanh, spread over the weights in use
+	const float Value = State.GetValue();
+	const float Step = Settings.LearningRate * (Target - Value) * (1.f - Value * Value);
+	const int32 Bank = State.SideToMove * Network.BankSize;
+	for (int32 WeightIndex : State.Indices)
+	{
+		Network.Weights[Bank + WeightIndex] += Step;
+	}
+}
@@ -0,0 +1,160 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeBoard.h"
+
+/**
+ * Learned evaluation for one Classic board shape. Every winning line window is an n-tuple whose
+ * cells (empty, Player 1, Player 2) index a table of weights, windows that a board symmetry maps
+ * onto each other share a table, and the value is tanh of the summed weights, from Player 1's
+ * point of view. Each side to move has its own bank of tables, since a threat is worth far more
+ * to the player about to move. Evaluate incrementally through FTicTacToeNTupleState.
+ */
+class TICTACTOE_API FTicTacToeNTupleNetwork
+{
+public:
+	/** Untrained network, every weight zero */
+	FTicTacToeNTupleNetwork(int32 InSize, int32 InWinLength);
+
+	FORCEINLINE int32 GetSize() const { return Size; }
+	FORCEINLINE int32 GetWinLength() const { return WinLength; }
+	FORCEINLINE int32 GetNumWeights() const { return Weights.Num(); }
+
+	/** Value of a position for Player 1, from -1 (lost) to 1 (won), evaluated from scratch */
+	float Evaluate(const FTicTacToeBoard& Board) const;
+
+	/** Writes the weights quantized to 16 bits, returning false if the file could not be written */
+	bool Save(const FString& Path) const;
+
+	/** Reads a file written by Save, returning null if it is missing or malformed */
+	static TUniquePtr<FTicTacToeNTupleNetwork> Load(const FString& Path);
+
+	/** Where the trained network for a board shape is looked for */
+	static FString GetDefaultPath(int32 Size, int32 WinLength);
+
+	/**
+	 * The trained network shipped for a board shape, loaded on first use, or null if there is none
+	 * or its file holds another shape
+	 */
+	static const FTicTacToeNTupleNetwork* FindTrained(int32 Size, int32 WinLength);
+
+private:
+	friend struct FTicTacToeNTupleState;
+	friend class FTicTacToeNTupleTrainer;
+
+	/** A window a cell belongs to, and what a mark in that cell adds to the window's weight index */
+	struct FCellWindow
+	{
+		int32 Window;
+		int32 Place;
+	};
+
+	int32 Size;
+	int32 WinLength;
+
+	/** 3^WinLength, the entries in one table */
+	int32 TableSize;
+
+	/** Weights in one side to move's bank, Player 2's bank follows Player 1's */
+	int32 BankSize;
+
+	/** Offset of each window's table in Player 1's bank */
+	TArray<int32> WindowTables;
+
+	/** Windows of each cell, indexed by CellWindowStart[Cell] .. CellWindowStart[Cell + 1] */
+	TArray<FCellWindow> CellWindows;
+	TArray<int32> CellWindowStart;
+
+	TArray<float> Weights;
+};
+
+/** A network's view of one game, updated as moves are made at a few dozen table reads per move */
+struct TICTACTOE_API FTicTacToeNTupleState
+{
+	explicit FTicTacToeNTupleState(const FTicTacToeNTupleNetwork& InNetwork);
+
+	/** Back to the empty board */
+	void Reset();
+
+	/** Rebuilds the state of a position */
+	void SetPosition(const FTicTacToeBoard& Board);
+
+	/** Player claimed the empty Cell */
+	void MakeMove(int32 Cell, int32 Player);
+
+	/** Player's mark on Cell was taken back */
+	void UndoMove(int32 Cell, int32 Player);
+
+	/** Value for Player 1, from -1 (lost) to 1 (won) */
+	FORCEINLINE float GetValue() const { return GetValue(SideToMove); }
+
+	/** Value for Player 1 were Side to move */
+	float GetValue(int32 Side) const;
+
+	/** Re-sums the weights after they have changed under this state */
+	void Refresh();
+
+	const FTicTacToeNTupleNetwork& Network;
+
+	/** Current weight index of every window in Player 1's bank */
+	TArray<int32> Indices;
+
+	/** Sum of the weights at Indices, in each side to move's bank */
+	float Sums[2];
+
+	int32 SideToMove;
+};
+
+struct TICTACTOE_API FTicTacToeNTupleTrainingSettings
+{
+	FTicTacToeNTupleTrainingSettings()
+		: Games(100000)
+		, LearningRate(0.01f)
+		, Exploration(0.1f)
+		, Seed(0)
+	{
+	}
+
+	/** Self-play games to learn from */
+	int32 Games;
+
+	/** Step size per weight per update */
+	float LearningRate;
+
+	/** Chance of playing a random move instead of the best one, decaying to a tenth over the run */
+	float Exploration;
+
+	int32 Seed;
+};
+
+/** Learns weights offline by TD(0) self-play on the afterstates of greedy one ply lookahead */
+class TICTACTOE_API FTicTacToeNTupleTrainer
+{
+public:
+	FTicTacToeNTupleTrainer(FTicTacToeNTupleNetwork& InNetwork, const FTicTacToeNTupleTrainingSettings& InSettings);
+
+	/** Plays Count more games, learning from each */
+	void Train(int32 Count);
+
+	/** Games played so far */
+	FORCEINLINE int32 GetGamesPlayed() const { return GamesPlayed; }
+
+	/** Player 1 wins, draws and Player 2 wins over the games since the last call */
+	void ConsumeResults(int32& OutWins, int32& OutDraws, int32& OutLosses);
+
+private:
+
+	void PlayGame();
+
+	/** Moves State's value towards Target */
+	void Update(const FTicTacToeNTupleState& State, float Target);
+
+	FTicTacToeNTupleNetwork& Network;
+	FTicTacToeNTupleTrainingSettings Settings;
+	FRandomStream Random;
+
+	int32 GamesPlayed;
+	int32 Results[3];
+};
@@ -0,0 +1,233 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToePonder.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/ScopeLock.h"
+
+FTicTacToePonderer::FTicTacToePonderer(const FTicTacToeAIPlayerSettings& Settings, int32 Seed)
+	: AIPlayer(Settings, Seed)
+	, Thread(nullptr)
+	, WorkEvent(nullptr)
+	, PendingJob(EJob::None)
+	, Generation(0)
+	, PonderingKey(0)
+	, bPonderingRequested(false)
+	, bMoveReady(false)
+	, ReadyMove(INDEX_NONE)
+	, bStopSearch(false)
+	, bExit(false)
+{
+	SearchControl.StopFlag = &bStopSearch;
+	AIPlayer.SetSearchControl(&SearchControl);
+
+	// Without threads every request is searched on the calling thread instead
+	if (FPlatformProcess::SupportsMultithreading())
+	{
+		WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		Thread = FRunnableThread::Create(this, TEXT("TicTacToePonderer"), 0, TPri_BelowNormal);
+	}
+}
+
+FTicTacToePonderer::~FTicTacToePonderer()
+{
+	if (Thread != nullptr)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (WorkEvent != nullptr)
+	{
+		FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+		WorkEvent = nullptr;
+	}
+}
+
+void FTicTacToePonderer::StartPondering(const FTicTacToePosition& Position)
+{
+	if (Thread == nullptr)
+		return;
+
+	FScopeLock Lock(&Mutex);
+	PonderedReplies.Reset();
+	bMoveReady = false;
+	SetJob(EJob::Ponder, Position);
+}
+
+void FTicTacToePonderer::RequestMove(const FTicTacToePosition& Position)
+{
+	const uint64 Key = Position.GetKey();
+
+	if (Thread == nullptr)
+	{
+		FTicTacToeSearchStats Stats;
+		bMoveReady = true;
+		ReadyMove = AIPlayer.ChooseMove(Position, Stats);
+		return;
+	}
+
+	FScopeLock Lock(&Mutex);
+
+	// Already pondered, answer straight away
+	if (const int32* Reply = PonderedReplies.Find(Key))
+	{
+		bMoveReady = true;
+		ReadyMove = *Reply;
+		SetJob(EJob::None, Position);
+		return;
+	}
+
+	// Being pondered right now, let that search finish and deliver
+	if (PendingJob == EJob::None && PonderingKey == Key)
+	{
+		bPonderingRequested = true;
+		return;
+	}
+
+	bMoveReady = false;
+	SetJob(EJob::Search, Position);
+}
+
+void FTicTacToePonderer::Cancel()
+{
+	FScopeLock Lock(&Mutex);
+	bMoveReady = false;
+	SetJob(EJob::None, PendingPosition);
+}
+
+bool FTicTacToePonderer::PollMove(int32& OutBlockIndex)
+{
+	FScopeLock Lock(&Mutex);
+	if (!bMoveReady)
+		return false;
+
+	bMoveReady = false;
+	OutBlockIndex = ReadyMove;
+	return true;
+}
+
+void FTicTacToePonderer::SetJob(EJob Job, const FTicTacToePosition& Position)
+{
+	Generation++;
+	PendingJob = Job;
+	PendingPosition = Position;
+	PonderingKey = 0;
+	bPonderingRequested = false;
+
+	// Whatever the worker is doing belongs to an older generation now
+	bStopSearch = true;
+	if (Job != EJob::None)
+	{
+		WorkEvent->Trigger();
+	}
+}
+
+uint32 FTicTacToePonderer::Run()
+{
+	while (!bExit)
+	{
+		WorkEvent->Wait();
+
+		EJob Job;
+		FTicTacToePosition Position;
+		uint32 JobGeneration;
+		{
+			FScopeLock Lock(&Mutex);
+			Job = PendingJob;
+			Position = PendingPosition;
+			JobGeneration = Generation;
+			PendingJob = EJob::None;
+			bStopSearch = false;
+		}
+
+		if (bExit)
+			break;
+
+		if (Job == EJob::Ponder)
+		{
+			Ponder(Position, JobGeneration);
+		}
+		else if (Job == EJob::Search)
+		{
+			Search(Position, JobGeneration);
+		}
+	}
+	return 0;
+}
+
+void FTicTacToePonderer::Stop()
+{
+	bExit = true;
+	bStopSearch = true;
+	WorkEvent->Trigger();
+}
+
+void FTicTacToePonderer::Ponder(const FTicTacToePosition& Position, uint32 JobGeneration)
+{
+	int32 Moves[FTicTacToePosition::MaxMoves];
+	const int32 NumMoves = Position.GenerateMoves(Moves);
+
+	// Predict the human's move with the AI's own search and ponder that first
+	FTicTacToeSearchStats Stats;
+	const int32 Predicted = AIPlayer.ChooseMove(Position, Stats);
+	if (bStopSearch)
+		return;
+
+	for (int32 Index = 0; Index < NumMoves; Index++)
+	{
+		if (Moves[Index] == Predicted)
+		{
+			Swap(Moves[0], Moves[Index]);
+			break;
+		}
+	}
+
+	for (int32 Index = 0; Index < NumMoves; Index++)
+	{
+		FTicTacToePosition Child = Position;
+		Child.MakeMove(Moves[Index]);
+		if (Child.IsGameOver())
+			continue;
+
+		const uint64 Key = Child.GetKey();
+		{
+			FScopeLock Lock(&Mutex);
+			if (Generation != JobGeneration)
+				return;
+			PonderingKey = Key;
+		}
+
+		const int32 Reply = AIPlayer.ChooseMove(Child, Stats);
+
+		FScopeLock Lock(&Mutex);
+		if (Generation != JobGeneration || bStopSearch)
+			return;
+
+		PonderingKey = 0;
+		if (bPonderingRequested)
+		{
+			// The human played this move while it was being searched
+			bPonderingRequested = false;
+			bMoveReady = true;
+			ReadyMove = Reply;
+			return;
+		}
+		PonderedReplies.Add(Key, Reply);
+	}
+}
+
+void FTicTacToePonderer::Search(const FTicTacToePosition& Position, uint32 JobGeneration)
+{
+	FTicTacToeSearchStats Stats;
+	const int32 Reply = AIPlayer.ChooseMove(Position, Stats);
+
+	FScopeLock Lock(&Mutex);
+	if (Generation == JobGeneration && !bStopSearch)
+	{
+		bMoveReady = true;
+		ReadyMove = Reply;
+	}
+}
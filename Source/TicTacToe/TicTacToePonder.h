@@ -0,0 +1,91 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "TicTacToeAIPlayer.h"
+
+/**
+ * Runs the AI on a worker thread. While the human is thinking it searches the AI's reply to
+ * each of their likely moves, most likely first, so a pondered move can be answered at once.
+ *
+ * All public functions are called from the game thread and never wait on a search; the chosen
+ * move is collected with PollMove.
+ */
+class TICTACTOE_API FTicTacToePonderer : public FRunnable
+{
+public:
+	FTicTacToePonderer(const FTicTacToeAIPlayerSettings& Settings, int32 Seed);
+	virtual ~FTicTacToePonderer();
+
+	/** Start searching replies to the human's candidate moves in Position */
+	void StartPondering(const FTicTacToePosition& Position);
+
+	/** Ask for the AI's move in Position. Answered immediately if it was pondered. */
+	void RequestMove(const FTicTacToePosition& Position);
+
+	/** Drop any work in progress, e.g. when the game ends */
+	void Cancel();
+
+	/** Collects the requested move once it is ready */
+	bool PollMove(int32& OutBlockIndex);
+
+	// Begin FRunnable interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+
+	enum class EJob : uint8
+	{
+		None,
+		Ponder,
+		Search
+	};
+
+	void Ponder(const FTicTacToePosition& Position, uint32 JobGeneration);
+
+	void Search(const FTicTacToePosition& Position, uint32 JobGeneration);
+
+	/** Replace whatever the worker is doing with a new job. Mutex must be held. */
+	void SetJob(EJob Job, const FTicTacToePosition& Position);
+
+	/** Only touched by whichever thread runs searches */
+	FTicTacToeAIPlayer AIPlayer;
+
+	/** Lets the game thread stop the worker's search */
+	FTicTacToeSearchControl SearchControl;
+
+	FRunnableThread* Thread;
+
+	/** Wakes the worker when a job is queued */
+	FEvent* WorkEvent;
+
+	/** Guards everything below up to the atomics */
+	FCriticalSection Mutex;
+
+	EJob PendingJob;
+	FTicTacToePosition PendingPosition;
+
+	/** Bumped whenever queued work changes, so stale results are dropped */
+	uint32 Generation;
+
+	/** AI replies found while pondering, keyed by the position after the human's move */
+	TMap<uint64, int32> PonderedReplies;
+
+	/** Position whose reply is being pondered right now, and whether it has been requested */
+	uint64 PonderingKey;
+	bool bPonderingRequested;
+
+	/** Move handed back to the game thread */
+	bool bMoveReady;
+	int32 ReadyMove;
+
+	/** Raised to cut the search in progress short */
+	TAtomic<bool> bStopSearch;
+
+	/** Raised to end the worker thread */
+	TAtomic<bool> bExit;
+};
@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToePosition.h"
+
+FTicTacToePosition::FTicTacToePosition(ETicTacToeGridMode InMode, int32 InSize)
+	: Mode(InMode)
+	, Classic(InSize, 3)
+{
+}
+
+void FTicTacToePosition::Reset()
+{
+	Classic.Reset();
+	Ultimate.Reset();
+	Qubic.Reset();
+}
+
+bool FTicTacToePosition::IsLegal(int32 BlockIndex) const
+{
+	switch (Mode)
+	{
+	case ETicTacToeGridMode::Ultimate:
+		return Ultimate.IsLegal(FTicTacToeUltimateBoard::MoveFromGridIndex(BlockIndex));
+	case ETicTacToeGridMode::Qubic:
+		return BlockIndex >= 0 && BlockIndex < FTicTacToeQubicBoard::NumCells && !Qubic.IsGameOver() && Qubic.IsEmpty(BlockIndex);
+	default:
+		return BlockIndex >= 0 && BlockIndex < Classic.NumCells && !Classic.IsGameOver() && Classic.IsEmpty(BlockIndex);
+	}
+}
+
+void FTicTacToePosition::MakeMove(int32 BlockIndex)
+{
+	switch (Mode)
+	{
+	case ETicTacToeGridMode::Ultimate:
+		Ultimate.MakeMove(FTicTacToeUltimateBoard::MoveFromGridIndex(BlockIndex));
+		break;
+	case ETicTacToeGridMode::Qubic:
+		Qubic.MakeMove(BlockIndex);
+		break;
+	default:
+		Classic.MakeMove(BlockIndex);
+		break;
+	}
+}
+
+int32 FTicTacToePosition::GenerateMoves(int32* OutMoves) const
+{
+	if (IsGameOver())
+		return 0;
+
+	if (Mode == ETicTacToeGridMode::Ultimate)
+	{
+		uint8 Moves[MaxMoves];
+		const int32 NumMoves = Ultimate.GenerateMoves(Moves);
+		for (int32 Index = 0; Index < NumMoves; Index++)
+		{
+			OutMoves[Index] = FTicTacToeUltimateBoard::GridIndexFromMove(Moves[Index]);
+		}
+		return NumMoves;
+	}
+
+	int32 NumMoves = 0;
+	for (uint64 Empty = Mode == ETicTacToeGridMode::Qubic ? Qubic.GetEmptyMask() : Classic.GetEmptyMask(); Empty; Empty &= Empty - 1)
+	{
+		OutMoves[NumMoves++] = FMath::CountTrailingZeros64(Empty);
+	}
+	return NumMoves;
+}
+
+bool FTicTacToePosition::IsGameOver() const
+{
+	return GetResult() != ETicTacToeResult::InProgress;
+}
+
+ETicTacToeResult FTicTacToePosition::GetResult() const
+{
+	switch (Mode)
+	{
+	case ETicTacToeGridMode::Ultimate:
+		return Ultimate.Result;
+	case ETicTacToeGridMode::Qubic:
+		return Qubic.Result;
+	default:
+		return Classic.Result;
+	}
+}
+
+int32 FTicTacToePosition::GetSideToMove() const
+{
+	switch (Mode)
+	{
+	case ETicTacToeGridMode::Ultimate:
+		return Ultimate.GetSideToMove();
+	case ETicTacToeGridMode::Qubic:
+		return Qubic.GetSideToMove();
+	default:
+		return Classic.GetSideToMove();
+	}
+}
+
+uint64 FTicTacToePosition::GetKey() const
+{
+	switch (Mode)
+	{
+	case ETicTacToeGridMode::Ultimate:
+	{
+		// The forced sub-board is part of the position, the marks alone are not enough
+		uint64 Key = 0xCBF29CE484222325ull ^ uint64(uint8(Ultimate.ForcedSubBoard));
+		for (int32 SubBoard = 0; SubBoard < 9; SubBoard++)
+		{
+			Key = (Key ^ (uint64(Ultimate.Cells[0][SubBoard]) | uint64(Ultimate.Cells[1][SubBoard]) << 16)) * 0x100000001B3ull;
+		}
+		return Key;
+	}
+	case ETicTacToeGridMode::Qubic:
+		return Qubic.Marks[0] * 0x9E3779B97F4A7C15ull ^ Qubic.Marks[1] * 0xC2B2AE3D27D4EB4Full;
+	default:
+		return Classic.GetKey();
+	}
+}
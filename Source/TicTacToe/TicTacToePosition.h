@@ -0,0 +1,59 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeBoard.h"
+#include "TicTacToeUltimateBoard.h"
+#include "TicTacToeQubicBoard.h"
+#include "TicTacToePosition.generated.h"
+
+/** Rule set played on the grid */
+UENUM(BlueprintType)
+enum class ETicTacToeGridMode : uint8
+{
+	/** Size x Size grid, three in a row wins */
+	Classic,
+	/** 3x3 of 3x3 sub-boards, your move picks the opponent's next sub-board */
+	Ultimate,
+	/** 4x4x4 cube in four stacked planes, four in a row in any direction wins */
+	Qubic
+};
+
+/** Rules state for any grid mode, with moves addressed by grid block index */
+struct TICTACTOE_API FTicTacToePosition
+{
+	FTicTacToePosition(ETicTacToeGridMode InMode = ETicTacToeGridMode::Classic, int32 InSize = 3);
+
+	/** Start a new game in the same mode */
+	void Reset();
+
+	/** Is claiming this block legal for the side to move? */
+	bool IsLegal(int32 BlockIndex) const;
+
+	/** Claim a block for the side to move */
+	void MakeMove(int32 BlockIndex);
+
+	/** Fills OutMoves with every legal block index, returning the count (at most MaxMoves) */
+	int32 GenerateMoves(int32* OutMoves) const;
+
+	bool IsGameOver() const;
+
+	ETicTacToeResult GetResult() const;
+
+	/** 0 when the player who moved first is to move */
+	int32 GetSideToMove() const;
+
+	/** Hash of the position, equal positions of the same mode give equal keys */
+	uint64 GetKey() const;
+
+	/** Upper bound on legal moves in any mode */
+	static constexpr int32 MaxMoves = 81;
+
+	ETicTacToeGridMode Mode;
+
+	/** Only the board matching Mode is in use */
+	FTicTacToeBoard Classic;
+	FTicTacToeUltimateBoard Ultimate;
+	FTicTacToeQubicBoard Qubic;
+};
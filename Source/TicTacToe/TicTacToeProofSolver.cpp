@@ -0,0 +1,424 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeProofSolver.h"
+#include "TicTacToeSymmetry.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** "TTPN" */
+	constexpr uint32 CheckpointMagic = 0x4E505454;
+	constexpr uint16 CheckpointVersion = 1;
+
+	/** Collect garbage once this fraction of the table is in use */
+	constexpr double MaxLoad = 0.75;
+
+	/** Nodes between deadline checks */
+	constexpr int64 DeadlineCheckInterval = 4096;
+
+	FORCEINLINE uint32 AddNumbers(uint32 A, uint32 B)
+	{
+		if (A >= FTicTacToeProofSolver::Infinite || B >= FTicTacToeProofSolver::Infinite)
+			return FTicTacToeProofSolver::Infinite;
+
+		// Large sums stay just short of a proof
+		return uint32(FMath::Min<uint64>(uint64(A) + B, FTicTacToeProofSolver::Infinite - 1));
+	}
+
+	/** Threshold for the best child, just past the second best so the search does not flip between them (the 1 + epsilon trick) */
+	FORCEINLINE uint32 GrowThreshold(uint32 Second)
+	{
+		if (Second >= FTicTacToeProofSolver::Infinite)
+			return FTicTacToeProofSolver::Infinite;
+
+		return uint32(FMath::Min<uint64>(FMath::Max<uint64>(uint64(Second) + 1, uint64(Second) + Second / 4), FTicTacToeProofSolver::Infinite - 1));
+	}
+}
+
+FTicTacToeProofSolver::FTicTacToeProofSolver(const FTicTacToeBoard& InRoot, int32 MemoryMB)
+	: Root(InRoot)
+	, Attacker(InRoot.GetSideToMove())
+	, Symmetry(FTicTacToeSymmetry::Get(InRoot.Size))
+	, NumEntries(0)
+	, BucketShift(64)
+	, Deadline(0.0)
+	, bAborted(false)
+{
+	// Largest power of two number of buckets within the budget
+	const int64 MaxBuckets = FMath::Max<int64>(1, int64(FMath::Max(1, MemoryMB)) * 1024 * 1024 / (BucketSize * sizeof(FEntry)));
+	int64 NumBuckets = 1;
+	while (NumBuckets * 2 <= MaxBuckets && NumBuckets * 2 * BucketSize <= MAX_int32)
+	{
+		NumBuckets *= 2;
+		BucketShift--;
+	}
+	Table.SetNumZeroed(int32(NumBuckets * BucketSize));
+}
+
+bool FTicTacToeProofSolver::Run(double Seconds)
+{
+	if (GetResult() != ETicTacToeProofResult::Unknown)
+		return true;
+
+	const double StartTime = FPlatformTime::Seconds();
+	Deadline = StartTime + Seconds;
+	bAborted = false;
+
+	// Every run starts again from the root, the table leads it straight back to where it was
+	FTicTacToeBoard Board = Root;
+	while (!bAborted && GetResult() == ETicTacToeProofResult::Unknown)
+	{
+		Search(Board, Infinite, Infinite, Stats.ProofNumber, Stats.DisproofNumber);
+	}
+
+	Stats.Seconds += FPlatformTime::Seconds() - StartTime;
+	return GetResult() != ETicTacToeProofResult::Unknown;
+}
+
+ETicTacToeProofResult FTicTacToeProofSolver::GetResult() const
+{
+	if (Stats.ProofNumber == 0)
+		return ETicTacToeProofResult::Win;
+
+	if (Stats.DisproofNumber == 0)
+		return ETicTacToeProofResult::NoWin;
+
+	return ETicTacToeProofResult::Unknown;
+}
+
+void FTicTacToeProofSolver::Search(FTicTacToeBoard& Board, uint32 ProofThreshold, uint32 DisproofThreshold, uint32& OutProof, uint32& OutDisproof)
+{
+	const int64 StartNodes = Stats.Nodes++;
+	if (Stats.Nodes % DeadlineCheckInterval == 0 && FPlatformTime::Seconds() >= Deadline)
+	{
+		bAborted = true;
+	}
+
+	const FTicTacToeCanonicalPosition Position = Symmetry.Canonicalize(Board);
+	const FEntry* Stored = Find(Position.Marks);
+	const uint64 PriorWork = Stored != nullptr ? Stored->Work : 0;
+
+	uint64 Moves = 0;
+	if (Evaluate(Board, OutProof, OutDisproof, Moves))
+	{
+		Store(Position.Marks, OutProof, OutDisproof, PriorWork + 1);
+		return;
+	}
+
+	// Children that are orientations of each other are one child. Their numbers are kept here
+	// rather than read back from the table, where a child's entry may be replaced while it is searched.
+	struct FChild
+	{
+		uint64 Marks[2];
+		int32 Cell;
+		uint32 ProofNumber;
+		uint32 DisproofNumber;
+	};
+	TArray<FChild, TInlineAllocator<64>> Children;
+	for (; Moves; Moves &= Moves - 1)
+	{
+		const int32 Cell = FMath::CountTrailingZeros64(Moves);
+		Board.MakeMove(Cell);
+		const FTicTacToeCanonicalPosition Child = Symmetry.Canonicalize(Board);
+		Board.UndoMove(Cell);
+
+		const bool bDuplicate = Children.ContainsByPredicate([&Child](const FChild& Other)
+		{
+			return Other.Marks[0] == Child.Marks[0] && Other.Marks[1] == Child.Marks[1];
+		});
+		if (!bDuplicate)
+		{
+			// Probing is bound by cache misses, so every child's bucket is fetched before any is read
+			const FEntry* Bucket = &Table[GetBucket(Child.Marks)];
+			FPlatformMisc::Prefetch(Bucket);
+			FPlatformMisc::Prefetch(Bucket, PLATFORM_CACHE_LINE_SIZE);
+			Children.Add({ { Child.Marks[0], Child.Marks[1] }, Cell, 1, 1 });
+		}
+	}
+
+	for (FChild& Child : Children)
+	{
+		if (const FEntry* Entry = Find(Child.Marks))
+		{
+			Child.ProofNumber = Entry->ProofNumber;
+			Child.DisproofNumber = Entry->DisproofNumber;
+		}
+	}
+
+	// At the attacker's nodes one proved child proves the node, at the defender's every child must be proved
+	const bool bAttackerToMove = Board.GetSideToMove() == Attacker;
+	while (true)
+	{
+		// Smallest and second smallest of the number that is minimized, and the sum of the other
+		uint32 Best = Infinite;
+		uint32 Second = Infinite;
+		uint32 Sum = 0;
+		int32 BestIndex = 0;
+		for (int32 Index = 0; Index < Children.Num(); Index++)
+		{
+			const FChild& Child = Children[Index];
+			const uint32 Minimized = bAttackerToMove ? Child.ProofNumber : Child.DisproofNumber;
+			Sum = AddNumbers(Sum, bAttackerToMove ? Child.DisproofNumber : Child.ProofNumber);
+			if (Minimized < Best)
+			{
+				Second = Best;
+				Best = Minimized;
+				BestIndex = Index;
+			}
+			else if (Minimized < Second)
+			{
+				Second = Minimized;
+			}
+		}
+
+		OutProof = bAttackerToMove ? Best : Sum;
+		OutDisproof = bAttackerToMove ? Sum : Best;
+		if (OutProof >= ProofThreshold || OutDisproof >= DisproofThreshold || bAborted)
+			break;
+
+		FChild& BestChild = Children[BestIndex];
+		uint32 ChildProofThreshold;
+		uint32 ChildDisproofThreshold;
+		if (bAttackerToMove)
+		{
+			ChildProofThreshold = FMath::Min(ProofThreshold, GrowThreshold(Second));
+			ChildDisproofThreshold = DisproofThreshold - OutDisproof + BestChild.DisproofNumber;
+		}
+		else
+		{
+			ChildProofThreshold = ProofThreshold - OutProof + BestChild.ProofNumber;
+			ChildDisproofThreshold = FMath::Min(DisproofThreshold, GrowThreshold(Second));
+		}
+
+		Board.MakeMove(BestChild.Cell);
+		Search(Board, ChildProofThreshold, ChildDisproofThreshold, BestChild.ProofNumber, BestChild.DisproofNumber);
+		Board.UndoMove(BestChild.Cell);
+	}
+
+	Store(Position.Marks, OutProof, OutDisproof, PriorWork + uint64(Stats.Nodes - StartNodes));
+}
+
+bool FTicTacToeProofSolver::Evaluate(const FTicTacToeBoard& Board, uint32& OutProof, uint32& OutDisproof, uint64& OutMoves) const
+{
+	// Decided positions are proved or disproved for the attacker
+	auto Settle = [&OutProof, &OutDisproof](bool bAttackerWins)
+	{
+		OutProof = bAttackerWins ? 0 : Infinite;
+		OutDisproof = bAttackerWins ? Infinite : 0;
+		return true;
+	};
+
+	if (Board.IsGameOver())
+		return Settle(Board.Result == (Attacker == 0 ? ETicTacToeResult::Player1Win : ETicTacToeResult::Player2Win));
+
+	// Cells completing a line for either side, and whether the attacker still has a line to complete
+	const int32 Mover = Board.GetSideToMove();
+	uint64 Wins[2] = { 0, 0 };
+	bool bAttackerHasLine = false;
+	for (uint64 Line : Board.GetLines().Lines)
+	{
+		const uint64 Own[2] = { Line & Board.Marks[0], Line & Board.Marks[1] };
+		for (int32 Player = 0; Player < 2; Player++)
+		{
+			if (Own[1 - Player] != 0)
+				continue;
+
+			bAttackerHasLine |= Player == Attacker;
+			if (FMath::CountBits(Own[Player]) == Board.WinLength - 1)
+			{
+				Wins[Player] |= Line & ~Own[Player];
+			}
+		}
+	}
+
+	if (!bAttackerHasLine)
+		return Settle(false);
+
+	if (Wins[Mover] != 0)
+		return Settle(Mover == Attacker);
+
+	// Two threats cannot both be blocked, one must be
+	if (FMath::CountBits(Wins[1 - Mover]) >= 2)
+		return Settle(Mover != Attacker);
+
+	OutMoves = Wins[1 - Mover] != 0 ? Wins[1 - Mover] : Board.GetEmptyMask();
+	OutProof = 1;
+	OutDisproof = 1;
+	return false;
+}
+
+const FTicTacToeProofSolver::FEntry* FTicTacToeProofSolver::Find(const uint64 Marks[2]) const
+{
+	const int64 Bucket = GetBucket(Marks);
+	for (int32 Slot = 0; Slot < BucketSize; Slot++)
+	{
+		const FEntry& Entry = Table[Bucket + Slot];
+		if (Entry.Work != 0 && Entry.Marks[0] == Marks[0] && Entry.Marks[1] == Marks[1])
+			return &Entry;
+	}
+	return nullptr;
+}
+
+void FTicTacToeProofSolver::Store(const uint64 Marks[2], uint32 ProofNumber, uint32 DisproofNumber, uint64 Work)
+{
+	const int64 Bucket = GetBucket(Marks);
+	FEntry* Target = nullptr;
+	for (int32 Slot = 0; Slot < BucketSize; Slot++)
+	{
+		FEntry& Entry = Table[Bucket + Slot];
+		if (Entry.Work != 0 && Entry.Marks[0] == Marks[0] && Entry.Marks[1] == Marks[1])
+		{
+			Target = &Entry;
+			break;
+		}
+		if (Entry.Work == 0 && Target == nullptr)
+		{
+			Target = &Entry;
+		}
+	}
+
+	if (Target == nullptr || Target->Work == 0)
+	{
+		if (NumEntries >= int64(Table.Num() * MaxLoad))
+		{
+			CollectGarbage();
+			Store(Marks, ProofNumber, DisproofNumber, Work);
+			return;
+		}
+
+		if (Target == nullptr)
+		{
+			// A full bucket gives up its entry with the least work
+			Target = &Table[Bucket];
+			for (int32 Slot = 1; Slot < BucketSize; Slot++)
+			{
+				if (Table[Bucket + Slot].Work < Target->Work)
+				{
+					Target = &Table[Bucket + Slot];
+				}
+			}
+		}
+		else
+		{
+			NumEntries++;
+		}
+	}
+
+	Target->Marks[0] = Marks[0];
+	Target->Marks[1] = Marks[1];
+	Target->ProofNumber = ProofNumber;
+	Target->DisproofNumber = DisproofNumber;
+	Target->Work = FMath::Max<uint64>(Work, 1);
+}
+
+void FTicTacToeProofSolver::CollectGarbage()
+{
+	// Entries binned by the magnitude of their work, freeing whole bins from the smallest up
+	int64 Counts[64] = { 0 };
+	for (const FEntry& Entry : Table)
+	{
+		if (Entry.Work != 0)
+		{
+			Counts[FMath::FloorLog2_64(Entry.Work)]++;
+		}
+	}
+
+	int32 MaxFreedBin = 0;
+	int64 Freed = Counts[0];
+	while (Freed < NumEntries / 2 && MaxFreedBin < 63)
+	{
+		Freed += Counts[++MaxFreedBin];
+	}
+
+	for (FEntry& Entry : Table)
+	{
+		if (Entry.Work != 0 && FMath::FloorLog2_64(Entry.Work) <= uint64(MaxFreedBin))
+		{
+			Entry.Work = 0;
+			NumEntries--;
+		}
+	}
+	Stats.GarbageCollections++;
+}
+
+bool FTicTacToeProofSolver::SaveCheckpoint(const FString& Path) const
+{
+	// Written beside the old checkpoint and swapped in, so a crash mid-write keeps the previous one
+	const FString TempPath = Path + TEXT(".tmp");
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+	if (!Writer.IsValid())
+		return false;
+
+	uint32 Magic = CheckpointMagic;
+	uint16 Version = CheckpointVersion;
+	uint8 Size = uint8(Root.Size);
+	uint8 WinLength = uint8(Root.WinLength);
+	uint64 RootMarks[2] = { Root.Marks[0], Root.Marks[1] };
+	FTicTacToeProofStats SavedStats = Stats;
+	int64 NumSaved = NumEntries;
+	*Writer << Magic << Version << Size << WinLength << RootMarks[0] << RootMarks[1];
+	*Writer << SavedStats.Nodes << SavedStats.Seconds << SavedStats.GarbageCollections << SavedStats.ProofNumber << SavedStats.DisproofNumber;
+	*Writer << NumSaved;
+
+	for (const FEntry& Entry : Table)
+	{
+		if (Entry.Work != 0)
+		{
+			FEntry Saved = Entry;
+			*Writer << Saved.Marks[0] << Saved.Marks[1] << Saved.ProofNumber << Saved.DisproofNumber << Saved.Work;
+		}
+	}
+
+	const bool bWritten = Writer->Close() && !Writer->IsError();
+	Writer.Reset();
+	if (!bWritten)
+	{
+		IFileManager::Get().Delete(*TempPath);
+		return false;
+	}
+	return IFileManager::Get().Move(*Path, *TempPath, true);
+}
+
+bool FTicTacToeProofSolver::LoadCheckpoint(const FString& Path)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+	if (!Reader.IsValid())
+		return false;
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	uint8 Size = 0;
+	uint8 WinLength = 0;
+	uint64 RootMarks[2] = { 0, 0 };
+	FTicTacToeProofStats LoadedStats;
+	int64 NumSaved = 0;
+	*Reader << Magic << Version << Size << WinLength << RootMarks[0] << RootMarks[1];
+	*Reader << LoadedStats.Nodes << LoadedStats.Seconds << LoadedStats.GarbageCollections << LoadedStats.ProofNumber << LoadedStats.DisproofNumber;
+	*Reader << NumSaved;
+
+	if (Reader->IsError() || Magic != CheckpointMagic || Version != CheckpointVersion
+		|| Size != Root.Size || WinLength != Root.WinLength || RootMarks[0] != Root.Marks[0] || RootMarks[1] != Root.Marks[1] || NumSaved < 0)
+		return false;
+
+	// A smaller table than the one saved keeps what it can, collecting garbage as it fills
+	for (FEntry& Entry : Table)
+	{
+		Entry.Work = 0;
+	}
+	NumEntries = 0;
+	Stats = LoadedStats;
+
+	for (int64 Index = 0; Index < NumSaved; Index++)
+	{
+		FEntry Entry;
+		*Reader << Entry.Marks[0] << Entry.Marks[1] << Entry.ProofNumber << Entry.DisproofNumber << Entry.Work;
+		if (Reader->IsError())
+			break;
+
+		Store(Entry.Marks, Entry.ProofNumber, Entry.DisproofNumber, Entry.Work);
+	}
+
+	// A truncated file still leaves a usable table, only the lost entries need searching again
+	return true;
+}
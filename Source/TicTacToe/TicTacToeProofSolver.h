@@ -0,0 +1,134 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeBoard.h"
+
+struct FTicTacToeSymmetry;
+
+/** What a proof search has established about its root */
+enum class ETicTacToeProofResult : uint8
+{
+	/** Not solved yet */
+	Unknown,
+	/** The side to move at the root forces a win */
+	Win,
+	/** The side to move at the root cannot force a win. From the empty board this is a draw, as a spare mark never hurts the first player. */
+	NoWin
+};
+
+/** Progress of a proof search, carried across checkpoints */
+struct TICTACTOE_API FTicTacToeProofStats
+{
+	FTicTacToeProofStats()
+		: Nodes(0)
+		, Seconds(0.0)
+		, GarbageCollections(0)
+		, ProofNumber(1)
+		, DisproofNumber(1)
+	{
+	}
+
+	/** Nodes expanded over every run */
+	int64 Nodes;
+
+	/** Time spent searching over every run */
+	double Seconds;
+
+	int32 GarbageCollections;
+
+	/** The root's current proof and disproof numbers */
+	uint32 ProofNumber;
+	uint32 DisproofNumber;
+};
+
+/**
+ * Depth-first proof-number (df-pn) solver for Classic positions, proving whether the side to move
+ * forces a win. Positions are stored under their canonical orientation in a table of fixed size.
+ * When the table fills up the entries with the least search work beneath them are discarded, so
+ * memory stays capped however long a solve runs. The table can be written to disk and read back,
+ * letting a solve that takes hours be stopped and resumed.
+ */
+class TICTACTOE_API FTicTacToeProofSolver
+{
+public:
+	/** Solver for Root using a table of at most MemoryMB megabytes */
+	FTicTacToeProofSolver(const FTicTacToeBoard& InRoot, int32 MemoryMB = 256);
+
+	/** Searches for up to Seconds, returning true once the root is solved */
+	bool Run(double Seconds);
+
+	ETicTacToeProofResult GetResult() const;
+
+	FORCEINLINE const FTicTacToeProofStats& GetStats() const { return Stats; }
+
+	/** Positions stored and the most the table can hold */
+	FORCEINLINE int64 GetNumEntries() const { return NumEntries; }
+	FORCEINLINE int64 GetCapacity() const { return Table.Num(); }
+
+	/** Writes the table and stats, replacing Path only once the whole file is written */
+	bool SaveCheckpoint(const FString& Path) const;
+
+	/** Reads a checkpoint of the same root, returning false if it is missing, malformed or of another root */
+	bool LoadCheckpoint(const FString& Path);
+
+	/** Proof and disproof number of a solved node */
+	static constexpr uint32 Infinite = 0x7FFFFFFF;
+
+private:
+
+	/** One stored position, free while Work is zero */
+	struct FEntry
+	{
+		/** Canonical marks per player */
+		uint64 Marks[2];
+
+		uint32 ProofNumber;
+		uint32 DisproofNumber;
+
+		/** Nodes expanded beneath this position, deciding what garbage collection keeps */
+		uint64 Work;
+	};
+
+	/** Entries sharing a bucket, probed together */
+	static constexpr int32 BucketSize = 4;
+
+	/** Expands Board until its proof or disproof number reaches its threshold, returning both numbers */
+	void Search(FTicTacToeBoard& Board, uint32 ProofThreshold, uint32 DisproofThreshold, uint32& OutProof, uint32& OutDisproof);
+
+	/** Settles positions decided without searching. Otherwise returns false with the cells worth playing. */
+	bool Evaluate(const FTicTacToeBoard& Board, uint32& OutProof, uint32& OutDisproof, uint64& OutMoves) const;
+
+	const FEntry* Find(const uint64 Marks[2]) const;
+
+	/** Stores a position, collecting garbage first if the table is getting full */
+	void Store(const uint64 Marks[2], uint32 ProofNumber, uint32 DisproofNumber, uint64 Work);
+
+	/** Frees at least half of the entries, those with the least work first */
+	void CollectGarbage();
+
+	FORCEINLINE int64 GetBucket(const uint64 Marks[2]) const
+	{
+		return int64((Marks[0] * 0x9E3779B97F4A7C15ull ^ Marks[1] * 0xC2B2AE3D27D4EB4Full) >> BucketShift) * BucketSize;
+	}
+
+	FTicTacToeBoard Root;
+
+	/** Side to move at the root, the side trying to win */
+	int32 Attacker;
+
+	const FTicTacToeSymmetry& Symmetry;
+
+	TArray<FEntry> Table;
+	int64 NumEntries;
+
+	/** Top bits of the position key pick the bucket */
+	int32 BucketShift;
+
+	FTicTacToeProofStats Stats;
+
+	/** When the current run stops */
+	double Deadline;
+	bool bAborted;
+};
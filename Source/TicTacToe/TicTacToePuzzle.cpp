@@ -0,0 +1,347 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToePuzzle.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/** "TTPZ" */
+	constexpr uint32 PackMagic = 0x5A505454;
+	constexpr uint16 PackVersion = 1;
+
+	/** Magic, version, win in and a puzzle count per board size */
+	constexpr int64 PackHeaderBytes = 4 + 2 + 1 + 4 * (FTicTacToeLineTable::MaxSize - 2);
+}
+
+FTicTacToeBoard FTicTacToePuzzle::GetBoard() const
+{
+	FTicTacToeBoard Board(Size, 3);
+	Board.Marks[0] = Marks[0];
+	Board.Marks[1] = Marks[1];
+	Board.MoveCount = FMath::CountBits(Marks[0]) + FMath::CountBits(Marks[1]);
+	return Board;
+}
+
+FTicTacToePuzzleSolver::FTicTacToePuzzleSolver(int64 InMaxNodes)
+	: MaxNodes(InMaxNodes)
+	, Nodes(0)
+	, QuestionEnd(InMaxNodes)
+	, bAborted(false)
+{
+}
+
+void FTicTacToePuzzleSolver::GetWins(const FTicTacToeBoard& Board, uint64 OutWins[2])
+{
+	OutWins[0] = OutWins[1] = 0;
+	for (uint64 Line : Board.GetLines().Lines)
+	{
+		const uint64 Own[2] = { Line & Board.Marks[0], Line & Board.Marks[1] };
+		for (int32 Player = 0; Player < 2; Player++)
+		{
+			if (Own[1 - Player] == 0 && FMath::CountBits(Own[Player]) == Board.WinLength - 1)
+			{
+				OutWins[Player] |= Line & ~Own[Player];
+			}
+		}
+	}
+}
+
+void FTicTacToePuzzleSolver::BeginQuestion()
+{
+	QuestionEnd = Nodes + MaxNodes;
+	bAborted = false;
+}
+
+int32 FTicTacToePuzzleSolver::FindUniqueWin(const FTicTacToeBoard& Board, int32 WinIn)
+{
+	BeginQuestion();
+	if (Board.IsGameOver() || WinIn < 1)
+		return INDEX_NONE;
+
+	const int32 Attacker = Board.GetSideToMove();
+	uint64 Wins[2];
+	GetWins(Board, Wins);
+	if (Wins[1 - Attacker] != 0)
+		return INDEX_NONE;
+
+	// A win in one is unique when only one cell completes a line
+	if (WinIn == 1)
+		return FMath::CountBits(Wins[Attacker]) == 1 ? FMath::CountTrailingZeros64(Wins[Attacker]) : INDEX_NONE;
+
+	FTicTacToeBoard Work = Board;
+	if (Wins[Attacker] != 0 || AttackerWins(Work, WinIn - 1) || bAborted)
+		return INDEX_NONE;
+
+	int32 Solution = INDEX_NONE;
+	for (uint64 Moves = Work.GetEmptyMask(); Moves; Moves &= Moves - 1)
+	{
+		const int32 Cell = FMath::CountTrailingZeros64(Moves);
+		Work.MakeMove(Cell);
+		const bool bWins = DefenderLoses(Work, WinIn - 1);
+		Work.UndoMove(Cell);
+
+		if (bAborted)
+			return INDEX_NONE;
+
+		if (bWins)
+		{
+			if (Solution != INDEX_NONE)
+				return INDEX_NONE;
+
+			Solution = Cell;
+		}
+	}
+	return Solution;
+}
+
+bool FTicTacToePuzzleSolver::CanWin(const FTicTacToeBoard& Board, int32 WinIn)
+{
+	BeginQuestion();
+	if (Board.IsGameOver() || WinIn < 1)
+		return false;
+
+	FTicTacToeBoard Work = Board;
+	return AttackerWins(Work, WinIn) && !bAborted;
+}
+
+bool FTicTacToePuzzleSolver::AttackerWins(FTicTacToeBoard& Board, int32 WinIn)
+{
+	if (++Nodes > QuestionEnd)
+	{
+		bAborted = true;
+		return false;
+	}
+
+	const int32 Attacker = Board.GetSideToMove();
+	uint64 Wins[2];
+	GetWins(Board, Wins);
+	if (Wins[Attacker] != 0)
+		return true;
+
+	// Nothing wins at once, and two defender threats cannot both be blocked
+	if (WinIn == 1 || FMath::CountBits(Wins[1 - Attacker]) >= 2)
+		return false;
+
+	// A single defender threat must be blocked
+	for (uint64 Moves = Wins[1 - Attacker] != 0 ? Wins[1 - Attacker] : Board.GetEmptyMask(); Moves; Moves &= Moves - 1)
+	{
+		const int32 Cell = FMath::CountTrailingZeros64(Moves);
+		Board.MakeMove(Cell);
+		const bool bWins = DefenderLoses(Board, WinIn - 1);
+		Board.UndoMove(Cell);
+
+		if (bWins)
+			return true;
+		if (bAborted)
+			return false;
+	}
+	return false;
+}
+
+bool FTicTacToePuzzleSolver::DefenderLoses(FTicTacToeBoard& Board, int32 WinIn)
+{
+	if (++Nodes > QuestionEnd)
+	{
+		bAborted = true;
+		return false;
+	}
+
+	// The attacker's last move did not win, so a full board is a draw
+	if (Board.IsGameOver())
+		return false;
+
+	const int32 Defender = Board.GetSideToMove();
+	uint64 Wins[2];
+	GetWins(Board, Wins);
+	if (Wins[Defender] != 0)
+		return false;
+
+	const uint64 Threats = Wins[1 - Defender];
+	if (FMath::CountBits(Threats) >= 2)
+		return true;
+
+	// Without a threat the attacker's next move cannot win, whatever the defender plays
+	if (Threats == 0 && WinIn == 1)
+		return false;
+
+	// A single threat must be blocked, any other move loses at once
+	for (uint64 Moves = Threats != 0 ? Threats : Board.GetEmptyMask(); Moves; Moves &= Moves - 1)
+	{
+		const int32 Cell = FMath::CountTrailingZeros64(Moves);
+		Board.MakeMove(Cell);
+		const bool bWins = AttackerWins(Board, WinIn);
+		Board.UndoMove(Cell);
+
+		if (!bWins)
+			return false;
+	}
+	return true;
+}
+
+FTicTacToePuzzlePack::FTicTacToePuzzlePack()
+	: WinIn(0)
+{
+	Close();
+}
+
+FTicTacToePuzzlePack::~FTicTacToePuzzlePack()
+{
+}
+
+bool FTicTacToePuzzlePack::Open(const FString& Path)
+{
+	Close();
+
+	TUniquePtr<FArchive> File(IFileManager::Get().CreateFileReader(*Path));
+	if (!File.IsValid())
+		return false;
+
+	uint32 Magic = 0;
+	uint16 Version = 0;
+	uint8 FileWinIn = 0;
+	*File << Magic << Version << FileWinIn;
+	for (int32 SizeIndex = 0; SizeIndex < NumSizes; SizeIndex++)
+	{
+		*File << Counts[SizeIndex];
+	}
+
+	if (File->IsError() || Magic != PackMagic || Version != PackVersion || FileWinIn < 1)
+	{
+		Close();
+		return false;
+	}
+
+	// Puzzles follow the index grouped by size, so the offsets follow from the counts
+	int64 Offset = PackHeaderBytes;
+	for (int32 SizeIndex = 0; SizeIndex < NumSizes; SizeIndex++)
+	{
+		if (Counts[SizeIndex] < 0)
+		{
+			Close();
+			return false;
+		}
+		Offsets[SizeIndex] = Offset;
+		Offset += int64(Counts[SizeIndex]) * GetRecordBytes(SizeIndex + 3);
+	}
+
+	if (Offset > File->TotalSize())
+	{
+		Close();
+		return false;
+	}
+
+	Reader = MoveTemp(File);
+	WinIn = FileWinIn;
+	return true;
+}
+
+void FTicTacToePuzzlePack::Close()
+{
+	Reader.Reset();
+	WinIn = 0;
+	for (int32 SizeIndex = 0; SizeIndex < NumSizes; SizeIndex++)
+	{
+		Offsets[SizeIndex] = 0;
+		Counts[SizeIndex] = 0;
+	}
+}
+
+int32 FTicTacToePuzzlePack::GetNumPuzzles(int32 Size) const
+{
+	return Size >= 3 && Size <= FTicTacToeLineTable::MaxSize ? Counts[Size - 3] : 0;
+}
+
+bool FTicTacToePuzzlePack::LoadPuzzle(int32 Size, int32 Index, FTicTacToePuzzle& OutPuzzle)
+{
+	if (!IsOpen() || Index < 0 || Index >= GetNumPuzzles(Size))
+		return false;
+
+	const int32 MaskBytes = GetMaskBytes(Size);
+	uint8 Record[17];
+	Reader->Seek(Offsets[Size - 3] + int64(Index) * GetRecordBytes(Size));
+	Reader->Serialize(Record, GetRecordBytes(Size));
+	if (Reader->IsError())
+		return false;
+
+	OutPuzzle.Size = Size;
+	for (int32 Player = 0; Player < 2; Player++)
+	{
+		OutPuzzle.Marks[Player] = 0;
+		for (int32 Byte = 0; Byte < MaskBytes; Byte++)
+		{
+			OutPuzzle.Marks[Player] |= uint64(Record[Player * MaskBytes + Byte]) << (8 * Byte);
+		}
+	}
+	OutPuzzle.Solution = Record[2 * MaskBytes];
+
+	// A damaged record must not reach the grid
+	const uint64 FullMask = Size == 8 ? ~0ull : (1ull << (Size * Size)) - 1;
+	return (OutPuzzle.Marks[0] & OutPuzzle.Marks[1]) == 0 && ((OutPuzzle.Marks[0] | OutPuzzle.Marks[1]) & ~FullMask) == 0
+		&& OutPuzzle.Solution < Size * Size && !(((OutPuzzle.Marks[0] | OutPuzzle.Marks[1]) >> OutPuzzle.Solution) & 1);
+}
+
+bool FTicTacToePuzzlePack::Write(const FString& Path, int32 WinIn, TArray<FTicTacToePuzzle>& Puzzles)
+{
+	// Grouped by size to match the index, then ordered by marks so a pack is reproducible
+	Puzzles.Sort([](const FTicTacToePuzzle& A, const FTicTacToePuzzle& B)
+	{
+		if (A.Size != B.Size)
+			return A.Size < B.Size;
+		return A.Marks[0] != B.Marks[0] ? A.Marks[0] < B.Marks[0] : A.Marks[1] < B.Marks[1];
+	});
+
+	// Written beside the old pack and swapped in, so a crash mid-write keeps the previous one
+	const FString TempPath = Path + TEXT(".tmp");
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempPath));
+	if (!Writer.IsValid())
+		return false;
+
+	uint32 Magic = PackMagic;
+	uint16 Version = PackVersion;
+	uint8 FileWinIn = uint8(WinIn);
+	*Writer << Magic << Version << FileWinIn;
+	for (int32 Size = 3; Size <= FTicTacToeLineTable::MaxSize; Size++)
+	{
+		int32 Count = 0;
+		for (const FTicTacToePuzzle& Puzzle : Puzzles)
+		{
+			Count += Puzzle.Size == Size;
+		}
+		*Writer << Count;
+	}
+
+	uint8 Record[17];
+	for (const FTicTacToePuzzle& Puzzle : Puzzles)
+	{
+		const int32 MaskBytes = GetMaskBytes(Puzzle.Size);
+		for (int32 Player = 0; Player < 2; Player++)
+		{
+			for (int32 Byte = 0; Byte < MaskBytes; Byte++)
+			{
+				Record[Player * MaskBytes + Byte] = uint8(Puzzle.Marks[Player] >> (8 * Byte));
+			}
+		}
+		Record[2 * MaskBytes] = uint8(Puzzle.Solution);
+		Writer->Serialize(Record, GetRecordBytes(Puzzle.Size));
+	}
+
+	const bool bWritten = Writer->Close() && !Writer->IsError();
+	Writer.Reset();
+	if (!bWritten)
+	{
+		IFileManager::Get().Delete(*TempPath);
+		return false;
+	}
+	return IFileManager::Get().Move(*Path, *TempPath, true);
+}
+
+FString FTicTacToePuzzlePack::GetDefaultPath(int32 WinIn)
+{
+	return FPaths::ProjectContentDir() / TEXT("Puzzles") / FString::Printf(TEXT("WinIn%d.bin"), WinIn);
+}
+
+int32 FTicTacToePuzzlePack::GetMaskBytes(int32 Size)
+{
+	return (Size * Size + 7) / 8;
+}
@@ -0,0 +1,131 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeBoard.h"
+
+class FArchive;
+
+/** A Classic position where the side to move wins in WinIn of its own moves with one move only */
+struct TICTACTOE_API FTicTacToePuzzle
+{
+	FTicTacToePuzzle()
+		: Size(3)
+		, Solution(INDEX_NONE)
+	{
+		Marks[0] = Marks[1] = 0;
+	}
+
+	/** Number of cells along each side, always three in a row to win */
+	int32 Size;
+
+	/** Claimed cells per player, Player 1 having moved first */
+	uint64 Marks[2];
+
+	/** The only cell that wins in time */
+	int32 Solution;
+
+	/** The puzzle as a board, with the solver to move */
+	FTicTacToeBoard GetBoard() const;
+};
+
+/**
+ * Proves "win in N" for Classic positions: can the side to move complete a line with at most
+ * N of its own moves whatever the opponent answers? Threats prune the search, since a defender
+ * facing one must block it and an attacker with no threat left cannot win on its next move.
+ */
+class TICTACTOE_API FTicTacToePuzzleSolver
+{
+public:
+	/** Solver that gives up on any one question after MaxNodes positions */
+	explicit FTicTacToePuzzleSolver(int64 InMaxNodes = 1000000);
+
+	/**
+	 * Returns the side to move's only winning move when it wins in exactly WinIn moves and in no
+	 * fewer, otherwise INDEX_NONE. Positions where the side to move must first block a threat are
+	 * not puzzles, as the answer is forced.
+	 */
+	int32 FindUniqueWin(const FTicTacToeBoard& Board, int32 WinIn);
+
+	/** Does the side to move win with at most WinIn of its own moves? */
+	bool CanWin(const FTicTacToeBoard& Board, int32 WinIn);
+
+	/** Positions visited since the solver was made */
+	FORCEINLINE int64 GetNodes() const { return Nodes; }
+
+	/** Did the last question run out of nodes? Its answer is then INDEX_NONE or false. */
+	FORCEINLINE bool WasAborted() const { return bAborted; }
+
+	/** Cells completing a line for each side */
+	static void GetWins(const FTicTacToeBoard& Board, uint64 OutWins[2]);
+
+private:
+
+	/** Attacker to move, winning with at most WinIn more of its moves */
+	bool AttackerWins(FTicTacToeBoard& Board, int32 WinIn);
+
+	/** Defender to move, the attacker having WinIn more moves to win */
+	bool DefenderLoses(FTicTacToeBoard& Board, int32 WinIn);
+
+	/** Starts counting nodes for a new question */
+	void BeginQuestion();
+
+	int64 MaxNodes;
+	int64 Nodes;
+	int64 QuestionEnd;
+	bool bAborted;
+};
+
+/**
+ * A pack of puzzles on disk, written by the puzzle commandlet. An index of board sizes is read
+ * up front and puzzles are read one at a time as they are needed, so a pack of any size costs
+ * a few bytes of memory. Each puzzle takes two cell masks of just enough bytes for its board and
+ * one byte for the solution, five bytes on 3x3 and seventeen on 8x8.
+ */
+class TICTACTOE_API FTicTacToePuzzlePack
+{
+public:
+	FTicTacToePuzzlePack();
+	~FTicTacToePuzzlePack();
+
+	/** Reads the header and index, returning false if the file is missing or malformed */
+	bool Open(const FString& Path);
+
+	void Close();
+
+	FORCEINLINE bool IsOpen() const { return Reader.IsValid(); }
+
+	/** Own moves the side to move needs to win in every puzzle of the pack */
+	FORCEINLINE int32 GetWinIn() const { return WinIn; }
+
+	/** Puzzles on boards of Size */
+	int32 GetNumPuzzles(int32 Size) const;
+
+	/** Reads one puzzle from disk, returning false if Index is out of range or the read fails */
+	bool LoadPuzzle(int32 Size, int32 Index, FTicTacToePuzzle& OutPuzzle);
+
+	/** Writes a pack, sorting Puzzles by size, replacing Path only once the whole file is written */
+	static bool Write(const FString& Path, int32 WinIn, TArray<FTicTacToePuzzle>& Puzzles);
+
+	/** Where the grid looks for a pack of WinIn puzzles */
+	static FString GetDefaultPath(int32 WinIn);
+
+private:
+
+	/** Bytes of one cell mask on boards of Size */
+	static int32 GetMaskBytes(int32 Size);
+
+	FORCEINLINE static int32 GetRecordBytes(int32 Size) { return 2 * GetMaskBytes(Size) + 1; }
+
+	/** Board sizes the index covers, 3..FTicTacToeLineTable::MaxSize */
+	static constexpr int32 NumSizes = FTicTacToeLineTable::MaxSize - 2;
+
+	TUniquePtr<FArchive> Reader;
+
+	int32 WinIn;
+
+	/** File offset of the first puzzle and number of puzzles per board size */
+	int64 Offsets[NumSizes];
+	int32 Counts[NumSizes];
+};
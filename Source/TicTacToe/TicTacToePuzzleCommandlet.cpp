@@ -0,0 +1,90 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToePuzzleCommandlet.h"
+#include "TicTacToe.h"
+#include "TicTacToePuzzleGenerator.h"
+#include "HAL/PlatformMisc.h"
+
+namespace
+{
+	/** Seconds between progress lines */
+	constexpr double ReportInterval = 30.0;
+}
+
+UTicTacToePuzzleCommandlet::UTicTacToePuzzleCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTicTacToePuzzleCommandlet::Main(const FString& Params)
+{
+	FTicTacToePuzzleSettings Settings;
+	Settings.NumThreads = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+
+	FString SizeList;
+	if (FParse::Value(*Params, TEXT("Sizes="), SizeList, false))
+	{
+		TArray<FString> Sizes;
+		SizeList.ParseIntoArray(Sizes, TEXT(","));
+		Settings.Sizes.Reset();
+		for (const FString& Size : Sizes)
+		{
+			Settings.Sizes.AddUnique(FMath::Clamp(FCString::Atoi(*Size), 3, FTicTacToeLineTable::MaxSize));
+		}
+	}
+
+	if (Settings.Sizes.Num() == 0)
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("No board sizes to generate"));
+		return 1;
+	}
+
+	double Minutes = 60.0;
+	FParse::Value(*Params, TEXT("WinIn="), Settings.WinIn);
+	FParse::Value(*Params, TEXT("Puzzles="), Settings.PuzzlesPerSize);
+	FParse::Value(*Params, TEXT("Minutes="), Minutes);
+	FParse::Value(*Params, TEXT("Threads="), Settings.NumThreads);
+	FParse::Value(*Params, TEXT("MaxNodes="), Settings.MaxNodes);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+
+	// The pack stores the depth in a byte and the grid has no use for longer puzzles
+	Settings.WinIn = FMath::Clamp(Settings.WinIn, 1, 9);
+
+	FString Output = FTicTacToePuzzlePack::GetDefaultPath(Settings.WinIn);
+	FParse::Value(*Params, TEXT("Output="), Output);
+
+	UE_LOG(LogTicTacToe, Display, TEXT("Generating win in %d puzzles: %d sizes, %d per size, %d threads, up to %.0f minutes, seed %d"),
+		Settings.WinIn, Settings.Sizes.Num(), Settings.PuzzlesPerSize, Settings.NumThreads, Minutes, Settings.Seed);
+
+	FTicTacToePuzzleGenerator Generator(Settings);
+	const double TotalSeconds = Minutes * 60.0;
+	bool bDone = false;
+	while (!bDone && Generator.GetSeconds() < TotalSeconds)
+	{
+		bDone = Generator.Run(FMath::Min(ReportInterval, TotalSeconds - Generator.GetSeconds()));
+
+		const double Hours = FMath::Max(Generator.GetSeconds(), 1e-6) / 3600.0;
+		UE_LOG(LogTicTacToe, Display, TEXT("%6.0f s  %8d puzzles  %10.0f puzzles/hour"),
+			Generator.GetSeconds(), Generator.GetPuzzles().Num(), Generator.GetPuzzles().Num() / Hours);
+	}
+
+	for (const FTicTacToePuzzleSizeStats& SizeStats : Generator.GetStats())
+	{
+		UE_LOG(LogTicTacToe, Display, TEXT("%dx%d: %6d puzzles from %10lld samples, %8lld symmetric duplicates, %6lld over the node limit, %8.0f nodes per sample"),
+			SizeStats.Size, SizeStats.Size, SizeStats.Puzzles, SizeStats.Samples, SizeStats.Duplicates, SizeStats.Aborted,
+			double(SizeStats.Nodes) / FMath::Max<int64>(1, SizeStats.Samples));
+	}
+
+	TArray<FTicTacToePuzzle> Puzzles = Generator.GetPuzzles();
+	if (!FTicTacToePuzzlePack::Write(Output, Settings.WinIn, Puzzles))
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("Failed to write '%s'"), *Output);
+		return 1;
+	}
+
+	UE_LOG(LogTicTacToe, Display, TEXT("Wrote %d puzzles to '%s'"), Puzzles.Num(), *Output);
+	return 0;
+}
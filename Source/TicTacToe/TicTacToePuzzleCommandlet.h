@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TicTacToePuzzleCommandlet.generated.h"
+
+/**
+ * Generates a pack of "win in N" puzzles for the grid's puzzle mode, sampling every board size
+ * on all cores until each size has -Puzzles puzzles, has run out of new ones, or -Minutes pass.
+ * The pack is written to Content/Puzzles/WinIn<N>.bin unless -Output says otherwise.
+ *
+ * UE4Editor-Cmd TicTacToe -run=TicTacToePuzzle [-WinIn=2] [-Sizes=3,4,5,6,7,8] [-Puzzles=5000]
+ *     [-Minutes=60] [-Threads=AllCores] [-MaxNodes=200000] [-Seed=0] [-Output=Path]
+ */
+UCLASS()
+class UTicTacToePuzzleCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTicTacToePuzzleCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
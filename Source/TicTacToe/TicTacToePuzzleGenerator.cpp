@@ -0,0 +1,171 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToePuzzleGenerator.h"
+#include "TicTacToeSymmetry.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	/** Moves a playout may run past its length to reach a position without threats */
+	constexpr int32 MaxSettleMoves = 8;
+}
+
+FTicTacToePuzzleGenerator::FTicTacToePuzzleGenerator(const FTicTacToePuzzleSettings& InSettings)
+	: Settings(InSettings)
+	, Seconds(0.0)
+	, NumRuns(0)
+{
+	Settings.WinIn = FMath::Max(1, Settings.WinIn);
+	Settings.NumThreads = FMath::Max(1, Settings.NumThreads);
+
+	for (int32 Size : Settings.Sizes)
+	{
+		FTicTacToePuzzleSizeStats& SizeStats = Stats.AddDefaulted_GetRef();
+		SizeStats.Size = FMath::Clamp(Size, 3, FTicTacToeLineTable::MaxSize);
+	}
+	PuzzleKeys.SetNum(Stats.Num());
+	DuplicatesSincePuzzle.SetNumZeroed(Stats.Num());
+}
+
+bool FTicTacToePuzzleGenerator::Run(double RunSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const double Deadline = StartTime + RunSeconds;
+	const int32 Run = NumRuns++;
+
+	ParallelFor(Settings.NumThreads, [this, Run, Deadline](int32 Worker)
+	{
+		RunWorker(Run * Settings.NumThreads + Worker, Deadline);
+	});
+
+	Seconds += FPlatformTime::Seconds() - StartTime;
+	return IsDone();
+}
+
+bool FTicTacToePuzzleGenerator::IsDone() const
+{
+	FScopeLock Lock(&Mutex);
+	for (int32 SizeIndex = 0; SizeIndex < Stats.Num(); SizeIndex++)
+	{
+		if (IsWanted(SizeIndex))
+			return false;
+	}
+	return true;
+}
+
+bool FTicTacToePuzzleGenerator::IsWanted(int32 SizeIndex) const
+{
+	return Stats[SizeIndex].Puzzles < Settings.PuzzlesPerSize && DuplicatesSincePuzzle[SizeIndex] < ExhaustedAfter;
+}
+
+int32 FTicTacToePuzzleGenerator::PickSize(FRandomStream& Random) const
+{
+	// Sizes share the workers evenly, so each fills at the rate its puzzles turn up
+	int32 Wanted[FTicTacToeLineTable::MaxSize];
+	int32 NumWanted = 0;
+	for (int32 SizeIndex = 0; SizeIndex < Stats.Num() && NumWanted < FTicTacToeLineTable::MaxSize; SizeIndex++)
+	{
+		if (IsWanted(SizeIndex))
+		{
+			Wanted[NumWanted++] = SizeIndex;
+		}
+	}
+	return NumWanted > 0 ? Wanted[Random.RandHelper(NumWanted)] : INDEX_NONE;
+}
+
+void FTicTacToePuzzleGenerator::RunWorker(int32 Worker, double Deadline)
+{
+	FRandomStream Random(HashCombine(GetTypeHash(Settings.Seed), GetTypeHash(Worker)));
+	FTicTacToePuzzleSolver Solver(Settings.MaxNodes);
+	FTicTacToeBoard Board;
+
+	while (FPlatformTime::Seconds() < Deadline)
+	{
+		int32 SizeIndex;
+		{
+			FScopeLock Lock(&Mutex);
+			SizeIndex = PickSize(Random);
+		}
+		if (SizeIndex == INDEX_NONE)
+			break;
+
+		const int32 Size = Stats[SizeIndex].Size;
+		if (!Sample(Size, Random, Board))
+		{
+			FScopeLock Lock(&Mutex);
+			Stats[SizeIndex].Samples++;
+			continue;
+		}
+
+		const int64 NodesBefore = Solver.GetNodes();
+		const int32 Solution = Solver.FindUniqueWin(Board, Settings.WinIn);
+
+		FScopeLock Lock(&Mutex);
+		FTicTacToePuzzleSizeStats& SizeStats = Stats[SizeIndex];
+		SizeStats.Samples++;
+		SizeStats.Nodes += Solver.GetNodes() - NodesBefore;
+		SizeStats.Aborted += Solver.WasAborted();
+		if (Solution == INDEX_NONE || !IsWanted(SizeIndex))
+			continue;
+
+		// Only puzzles are folded, the rare positions worth remembering
+		const FTicTacToeCanonicalPosition Canonical = FTicTacToeSymmetry::Get(Size).Canonicalize(Board);
+		if (PuzzleKeys[SizeIndex].Contains(Canonical.GetKey()))
+		{
+			SizeStats.Duplicates++;
+			DuplicatesSincePuzzle[SizeIndex]++;
+			continue;
+		}
+
+		FTicTacToePuzzle& Puzzle = Puzzles.AddDefaulted_GetRef();
+		Puzzle.Size = Size;
+		Puzzle.Marks[0] = Canonical.Marks[0];
+		Puzzle.Marks[1] = Canonical.Marks[1];
+		Puzzle.Solution = FTicTacToeSymmetry::Get(Size).TransformCell(Solution, Canonical.Transform);
+
+		PuzzleKeys[SizeIndex].Add(Canonical.GetKey());
+		DuplicatesSincePuzzle[SizeIndex] = 0;
+		SizeStats.Puzzles++;
+	}
+}
+
+bool FTicTacToePuzzleGenerator::Sample(int32 Size, FRandomStream& Random, FTicTacToeBoard& OutBoard) const
+{
+	// Three in a row leaves a choice of winning moves on any busier board, so puzzles are sparse whatever the size
+	OutBoard = FTicTacToeBoard(Size, 3);
+	const int32 NumMoves = Random.RandRange(2, FMath::Min(Size + 2, OutBoard.NumCells - 2));
+
+	// A win in one is a threat left standing, so those playouts end on a move that may ignore one
+	const bool bLeaveThreat = Settings.WinIn == 1;
+
+	for (int32 Move = 0; ; Move++)
+	{
+		const int32 Mover = OutBoard.GetSideToMove();
+		uint64 Wins[2];
+		FTicTacToePuzzleSolver::GetWins(OutBoard, Wins);
+		if (Move >= NumMoves && Wins[1 - Mover] == 0 && (Wins[Mover] != 0) == bLeaveThreat)
+			return true;
+
+		// Give up on playouts that take too long to quieten down
+		if (Move >= NumMoves + MaxSettleMoves)
+			return false;
+
+		// Nobody completes a line and threats are blocked, as players would
+		uint64 Moves = OutBoard.GetEmptyMask() & ~Wins[Mover];
+		if (Wins[1 - Mover] != 0 && !(bLeaveThreat && Move + 1 >= NumMoves))
+		{
+			Moves &= Wins[1 - Mover];
+		}
+		if (Moves == 0)
+			return false;
+
+		// Pick the Nth set bit of the candidate cells
+		for (int32 Skip = Random.RandHelper(FMath::CountBits(Moves)); Skip > 0; Skip--)
+		{
+			Moves &= Moves - 1;
+		}
+		OutBoard.MakeMove(FMath::CountTrailingZeros64(Moves));
+	}
+}
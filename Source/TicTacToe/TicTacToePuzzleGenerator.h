@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToePuzzle.h"
+
+struct TICTACTOE_API FTicTacToePuzzleSettings
+{
+	FTicTacToePuzzleSettings()
+		: WinIn(2)
+		, PuzzlesPerSize(5000)
+		, MaxNodes(200000)
+		, NumThreads(1)
+		, Seed(0)
+	{
+		Sizes = { 3, 4, 5, 6, 7, 8 };
+	}
+
+	/** Own moves the side to move needs to win, exactly */
+	int32 WinIn;
+
+	/** Board sizes to sample, always three in a row to win as on the grid */
+	TArray<int32> Sizes;
+
+	/** Puzzles wanted on each board size */
+	int32 PuzzlesPerSize;
+
+	/** Positions the solver may visit per candidate before skipping it */
+	int64 MaxNodes;
+
+	/** Workers sampling and solving in parallel */
+	int32 NumThreads;
+
+	int32 Seed;
+};
+
+/** Counters of one board size since generation started */
+struct TICTACTOE_API FTicTacToePuzzleSizeStats
+{
+	FTicTacToePuzzleSizeStats()
+		: Size(0)
+		, Samples(0)
+		, Duplicates(0)
+		, Aborted(0)
+		, Puzzles(0)
+		, Nodes(0)
+	{
+	}
+
+	int32 Size;
+
+	/** Playouts started, including those that never settled into a quiet position */
+	int64 Samples;
+
+	/** Puzzles found again, under some rotation or reflection of one already kept */
+	int64 Duplicates;
+
+	/** Samples skipped for needing more than MaxNodes */
+	int64 Aborted;
+
+	/** Verified puzzles kept */
+	int32 Puzzles;
+
+	/** Positions visited by the solver */
+	int64 Nodes;
+};
+
+/**
+ * Generates "win in N" puzzles offline. Workers draw quiet positions from short playouts where
+ * threats are blocked, or for win in one positions where a threat was left standing, and keep
+ * those where FTicTacToePuzzleSolver finds exactly one winning move at exactly the requested
+ * depth. Each puzzle is folded to its canonical orientation, so the symmetric copies of a kept
+ * puzzle are dropped, and a size whose puzzles keep turning up again is taken to have none left.
+ */
+class TICTACTOE_API FTicTacToePuzzleGenerator
+{
+public:
+	explicit FTicTacToePuzzleGenerator(const FTicTacToePuzzleSettings& InSettings);
+
+	/** Generates for up to Seconds, returning true once every size is done */
+	bool Run(double Seconds);
+
+	/** Is every size full, or out of distinct puzzles? */
+	bool IsDone() const;
+
+	FORCEINLINE const TArray<FTicTacToePuzzle>& GetPuzzles() const { return Puzzles; }
+
+	FORCEINLINE const TArray<FTicTacToePuzzleSizeStats>& GetStats() const { return Stats; }
+
+	FORCEINLINE const FTicTacToePuzzleSettings& GetSettings() const { return Settings; }
+
+	/** Time spent generating over every run */
+	FORCEINLINE double GetSeconds() const { return Seconds; }
+
+private:
+
+	/** One worker's loop until Deadline */
+	void RunWorker(int32 Worker, double Deadline);
+
+	/**
+	 * Draws a position with no threat on boards of Size, or for win in one with threats for the side
+	 * to move only, returning false if the playout found none
+	 */
+	bool Sample(int32 Size, FRandomStream& Random, FTicTacToeBoard& OutBoard) const;
+
+	/** A random size index that still wants puzzles, INDEX_NONE when done */
+	int32 PickSize(FRandomStream& Random) const;
+
+	/** Does the size at SizeIndex want more puzzles? */
+	bool IsWanted(int32 SizeIndex) const;
+
+	/** Kept puzzles found again in a row before a size counts as exhausted */
+	static constexpr int32 ExhaustedAfter = 1000;
+
+	FTicTacToePuzzleSettings Settings;
+
+	/** Guards everything below */
+	mutable FCriticalSection Mutex;
+
+	TArray<FTicTacToePuzzle> Puzzles;
+
+	/** Canonical keys of the puzzles kept, per size index */
+	TArray<TSet<uint64>> PuzzleKeys;
+
+	/** Kept puzzles found again since the last new one, per size index */
+	TArray<int32> DuplicatesSincePuzzle;
+
+	TArray<FTicTacToePuzzleSizeStats> Stats;
+
+	double Seconds;
+
+	/** Runs so far, keeping every run's random streams distinct */
+	int32 NumRuns;
+};
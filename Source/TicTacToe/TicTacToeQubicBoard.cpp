@@ -0,0 +1,450 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeQubicBoard.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** The 76 lines and the lines through each cell */
+	struct FQubicLines
+	{
+		TArray<uint64> Lines;
+		TArray<uint64> CellLines;
+		int32 CellLineStart[FTicTacToeQubicBoard::NumCells + 1];
+
+		/** Cells ordered by how many lines pass through them */
+		int8 MoveOrder[FTicTacToeQubicBoard::NumCells];
+
+		FQubicLines()
+		{
+			// Every direction whose first non-zero component is positive, so each line is found once
+			for (int32 DLayer = -1; DLayer <= 1; DLayer++)
+			{
+				for (int32 DRow = -1; DRow <= 1; DRow++)
+				{
+					for (int32 DColumn = -1; DColumn <= 1; DColumn++)
+					{
+						const int32 FirstNonZero = DLayer != 0 ? DLayer : (DRow != 0 ? DRow : DColumn);
+						if (FirstNonZero <= 0)
+							continue;
+
+						AddLines(DLayer, DRow, DColumn);
+					}
+				}
+			}
+			check(Lines.Num() == 76);
+
+			for (int32 Cell = 0; Cell < FTicTacToeQubicBoard::NumCells; Cell++)
+			{
+				CellLineStart[Cell] = CellLines.Num();
+				for (uint64 Line : Lines)
+				{
+					if ((Line >> Cell) & 1)
+					{
+						CellLines.Add(Line);
+					}
+				}
+				MoveOrder[Cell] = Cell;
+			}
+			CellLineStart[FTicTacToeQubicBoard::NumCells] = CellLines.Num();
+
+			// Stable insertion sort, most connected cells first
+			for (int32 Index = 1; Index < FTicTacToeQubicBoard::NumCells; Index++)
+			{
+				const int8 Cell = MoveOrder[Index];
+				int32 Insert = Index;
+				while (Insert > 0 && GetLineCount(MoveOrder[Insert - 1]) < GetLineCount(Cell))
+				{
+					MoveOrder[Insert] = MoveOrder[Insert - 1];
+					Insert--;
+				}
+				MoveOrder[Insert] = Cell;
+			}
+		}
+
+		FORCEINLINE int32 GetLineCount(int32 Cell) const { return CellLineStart[Cell + 1] - CellLineStart[Cell]; }
+
+	private:
+
+		void AddLines(int32 DLayer, int32 DRow, int32 DColumn)
+		{
+			for (int32 Layer = 0; Layer < 4; Layer++)
+			{
+				for (int32 Row = 0; Row < 4; Row++)
+				{
+					for (int32 Column = 0; Column < 4; Column++)
+					{
+						const int32 EndLayer = Layer + DLayer * 3;
+						const int32 EndRow = Row + DRow * 3;
+						const int32 EndColumn = Column + DColumn * 3;
+						if (EndLayer < 0 || EndLayer > 3 || EndRow < 0 || EndRow > 3 || EndColumn < 0 || EndColumn > 3)
+							continue;
+
+						uint64 Line = 0;
+						for (int32 Step = 0; Step < 4; Step++)
+						{
+							Line |= 1ull << ((Layer + DLayer * Step) * 16 + (Row + DRow * Step) * 4 + Column + DColumn * Step);
+						}
+						Lines.Add(Line);
+					}
+				}
+			}
+		}
+	};
+
+	const FQubicLines& GetQubicLines()
+	{
+		static const FQubicLines QubicLines;
+		return QubicLines;
+	}
+
+	enum EBound : int8
+	{
+		Exact,
+		Lower,
+		Upper
+	};
+
+	constexpr int32 WinScore = FTicTacToeEngine::WinScore;
+
+	/** Scores this close to WinScore are forced wins or losses */
+	constexpr int32 WinThreshold = WinScore - 100;
+
+	constexpr int32 TableBits = 18;
+
+	FORCEINLINE uint64 GetHash(const FTicTacToeQubicBoard& Board)
+	{
+		return Board.Marks[0] * 0x9E3779B97F4A7C15ull ^ Board.Marks[1] * 0xC2B2AE3D27D4EB4Full;
+	}
+}
+
+FTicTacToeQubicBoard::FTicTacToeQubicBoard()
+{
+	Reset();
+}
+
+void FTicTacToeQubicBoard::Reset()
+{
+	Marks[0] = Marks[1] = 0;
+	MoveCount = 0;
+	Result = ETicTacToeResult::InProgress;
+}
+
+void FTicTacToeQubicBoard::MakeMove(int32 Cell)
+{
+	checkSlow(IsEmpty(Cell) && !IsGameOver());
+
+	const int32 Player = GetSideToMove();
+	Marks[Player] |= 1ull << Cell;
+	MoveCount++;
+
+	if (IsWinThrough(Cell, Player))
+	{
+		Result = Player == 0 ? ETicTacToeResult::Player1Win : ETicTacToeResult::Player2Win;
+	}
+	else if (MoveCount == NumCells)
+	{
+		Result = ETicTacToeResult::Draw;
+	}
+}
+
+void FTicTacToeQubicBoard::UndoMove(int32 Cell)
+{
+	MoveCount--;
+	Marks[MoveCount & 1] &= ~(1ull << Cell);
+	Result = ETicTacToeResult::InProgress;
+}
+
+bool FTicTacToeQubicBoard::IsWinThrough(int32 Cell, int32 Player) const
+{
+	const FQubicLines& QubicLines = GetQubicLines();
+	const uint64 Own = Marks[Player];
+	for (int32 Index = QubicLines.CellLineStart[Cell]; Index < QubicLines.CellLineStart[Cell + 1]; Index++)
+	{
+		const uint64 Line = QubicLines.CellLines[Index];
+		if ((Own & Line) == Line)
+			return true;
+	}
+	return false;
+}
+
+uint64 FTicTacToeQubicBoard::GetThreats(int32 Player) const
+{
+	const uint64 Own = Marks[Player];
+	const uint64 Other = Marks[Player ^ 1];
+
+	uint64 Threats = 0;
+	for (uint64 Line : GetQubicLines().Lines)
+	{
+		const uint64 Missing = Line & ~Own;
+		if ((Missing & (Missing - 1)) == 0 && !(Line & Other))
+		{
+			Threats |= Missing;
+		}
+	}
+	return Threats;
+}
+
+const TArray<uint64>& FTicTacToeQubicBoard::GetLines()
+{
+	return GetQubicLines().Lines;
+}
+
+FTicTacToeQubicAI::FTicTacToeQubicAI(int32 InMaxDepth, double InTimeLimit)
+	: MaxDepth(InMaxDepth)
+	, TimeLimit(InTimeLimit)
+	, Control(nullptr)
+	, Deadline(0.0)
+	, bAborted(false)
+{
+}
+
+int32 FTicTacToeQubicAI::ChooseMove(const FTicTacToeQubicBoard& Board, FRandomStream& Random, FTicTacToeSearchStats& OutStats)
+{
+	const FQubicLines& QubicLines = GetQubicLines();
+	const int32 Side = Board.GetSideToMove();
+	const uint64 Empty = Board.GetEmptyMask();
+	OutStats.Nodes++;
+
+	// Forced replies need no search
+	const uint64 Wins = Board.GetThreats(Side) & Empty;
+	if (Wins)
+		return FMath::CountTrailingZeros64(Wins);
+
+	const uint64 Blocks = Board.GetThreats(Side ^ 1) & Empty;
+	if (Blocks)
+		return FMath::CountTrailingZeros64(Blocks);
+
+	if (Table.Num() == 0)
+	{
+		Table.SetNumZeroed(1 << TableBits);
+	}
+
+	// Shuffle cells of equal connectivity so play varies between games
+	TArray<int32, TInlineAllocator<64>> RootMoves;
+	for (int32 Cell : QubicLines.MoveOrder)
+	{
+		if ((Empty >> Cell) & 1)
+		{
+			RootMoves.Add(Cell);
+		}
+	}
+	for (int32 Index = RootMoves.Num() - 1; Index > 0; Index--)
+	{
+		const int32 Swap = Random.RandHelper(Index + 1);
+		if (QubicLines.GetLineCount(RootMoves[Swap]) == QubicLines.GetLineCount(RootMoves[Index]))
+		{
+			RootMoves.Swap(Swap, Index);
+		}
+	}
+
+	// The tighter of our own time limit and the caller's deadline
+	FTicTacToeQubicBoard Work = Board;
+	const double StartTime = FPlatformTime::Seconds();
+	Deadline = TimeLimit > 0.0 ? StartTime + TimeLimit : 0.0;
+	if (Control && Control->Deadline > 0.0)
+	{
+		Deadline = Deadline > 0.0 ? FMath::Min(Deadline, Control->Deadline) : Control->Deadline;
+	}
+	bAborted = false;
+	int32 BestCell = RootMoves[0];
+
+	// Iterative deepening with the previous best move searched first at each depth
+	for (int32 Depth = 1; Depth <= MaxDepth; Depth++)
+	{
+		int32 Alpha = -WinScore - 1;
+		int32 IterationBest = BestCell;
+
+		// Search the previous best first so cutoffs come early
+		RootMoves.Remove(BestCell);
+		RootMoves.Insert(BestCell, 0);
+
+		for (int32 Cell : RootMoves)
+		{
+			Work.MakeMove(Cell);
+			const int32 Score = -Negamax(Work, Depth - 1, -WinScore - 1, -Alpha, 1, OutStats);
+			Work.UndoMove(Cell);
+
+			if (bAborted)
+				break;
+
+			if (Score > Alpha)
+			{
+				Alpha = Score;
+				IterationBest = Cell;
+			}
+		}
+
+		// An interrupted iteration still improved on the previous best if it found a better first move
+		BestCell = IterationBest;
+
+		if (Control && !bAborted)
+		{
+			FTicTacToeSearchProgress Progress;
+			Progress.Depth = Depth;
+			Progress.Nodes = OutStats.Nodes;
+			Progress.Seconds = FPlatformTime::Seconds() - StartTime;
+			Progress.Score = Alpha;
+			Progress.BestMove = BestCell;
+			GetPrincipalVariation(Board, BestCell, Depth, Progress.PrincipalVariation);
+			Control->ReportProgress(Progress);
+		}
+
+		// A proven result will not change with more depth
+		if (bAborted || FMath::Abs(Alpha) >= WinThreshold)
+			break;
+	}
+	return BestCell;
+}
+
+int32 FTicTacToeQubicAI::Negamax(FTicTacToeQubicBoard& Board, int32 Depth, int32 Alpha, int32 Beta, int32 Ply, FTicTacToeSearchStats& OutStats)
+{
+	OutStats.Nodes++;
+
+	if ((OutStats.Nodes & 1023) == 0 && ((Deadline > 0.0 && FPlatformTime::Seconds() > Deadline) || (Control && Control->ShouldStop())))
+	{
+		bAborted = true;
+	}
+	if (bAborted)
+		return 0;
+
+	if (Board.IsGameOver())
+		return Board.Result == ETicTacToeResult::Draw ? 0 : -(WinScore - Ply);
+
+	const int32 Side = Board.GetSideToMove();
+	const uint64 Empty = Board.GetEmptyMask();
+
+	// Completing a line next move beats anything a search could find
+	if (Board.GetThreats(Side) & Empty)
+		return WinScore - (Ply + 1);
+
+	// Two open threats cannot both be blocked, one must be blocked immediately
+	const uint64 Blocks = Board.GetThreats(Side ^ 1) & Empty;
+	if (Blocks & (Blocks - 1))
+		return -(WinScore - (Ply + 2));
+
+	if (Depth <= 0 && !Blocks)
+		return Evaluate(Board);
+
+	// Transposition table probe, win scores are stored relative to this node
+	FEntry& Entry = Table[GetHash(Board) >> (64 - TableBits)];
+	const bool bHit = Entry.Marks[0] == Board.Marks[0] && Entry.Marks[1] == Board.Marks[1];
+	int32 TableCell = INDEX_NONE;
+	if (bHit)
+	{
+		TableCell = Entry.BestCell;
+		if (Entry.Depth >= Depth)
+		{
+			int32 Score = Entry.Score;
+			if (Score >= WinThreshold)
+				Score -= Ply;
+			else if (Score <= -WinThreshold)
+				Score += Ply;
+
+			if (Entry.Bound == Exact || (Entry.Bound == Lower && Score >= Beta) || (Entry.Bound == Upper && Score <= Alpha))
+				return Score;
+		}
+	}
+
+	const int32 OriginalAlpha = Alpha;
+	int32 BestScore = -WinScore - 1;
+	int32 BestCell = INDEX_NONE;
+
+	// Forced blocks are searched without using up depth
+	int8 Moves[FTicTacToeQubicBoard::NumCells];
+	int32 NumMoves = 0;
+	int32 ChildDepth = Depth - 1;
+	if (Blocks)
+	{
+		Moves[NumMoves++] = FMath::CountTrailingZeros64(Blocks);
+		ChildDepth = Depth;
+	}
+	else
+	{
+		if (TableCell != INDEX_NONE && ((Empty >> TableCell) & 1))
+		{
+			Moves[NumMoves++] = TableCell;
+		}
+		for (int8 Cell : GetQubicLines().MoveOrder)
+		{
+			if (((Empty >> Cell) & 1) && Cell != TableCell)
+			{
+				Moves[NumMoves++] = Cell;
+			}
+		}
+	}
+
+	for (int32 Index = 0; Index < NumMoves; Index++)
+	{
+		const int32 Cell = Moves[Index];
+		Board.MakeMove(Cell);
+		const int32 Score = -Negamax(Board, ChildDepth, -Beta, -Alpha, Ply + 1, OutStats);
+		Board.UndoMove(Cell);
+
+		if (bAborted)
+			return 0;
+
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestCell = Cell;
+			if (Score > Alpha)
+			{
+				Alpha = Score;
+				if (Alpha >= Beta)
+					break;
+			}
+		}
+	}
+
+	Entry.Marks[0] = Board.Marks[0];
+	Entry.Marks[1] = Board.Marks[1];
+	Entry.Score = BestScore >= WinThreshold ? BestScore + Ply : (BestScore <= -WinThreshold ? BestScore - Ply : BestScore);
+	Entry.Depth = Depth;
+	Entry.Bound = BestScore <= OriginalAlpha ? Upper : (BestScore >= Beta ? Lower : Exact);
+	Entry.BestCell = BestCell;
+	return BestScore;
+}
+
+void FTicTacToeQubicAI::GetPrincipalVariation(FTicTacToeQubicBoard Board, int32 FirstCell, int32 MaxLength, TArray<int32>& OutCells) const
+{
+	// Follow best moves stored in the table for as long as they are there and legal
+	int32 Cell = FirstCell;
+	while (OutCells.Num() < MaxLength && Cell >= 0 && Board.IsEmpty(Cell) && !Board.IsGameOver())
+	{
+		OutCells.Add(Cell);
+		Board.MakeMove(Cell);
+
+		const FEntry& Entry = Table[GetHash(Board) >> (64 - TableBits)];
+		if (Entry.Marks[0] != Board.Marks[0] || Entry.Marks[1] != Board.Marks[1])
+			break;
+
+		Cell = Entry.BestCell;
+	}
+}
+
+int32 FTicTacToeQubicAI::Evaluate(const FTicTacToeQubicBoard& Board)
+{
+	// Open lines by number of marks, lines holding both colours are dead
+	static const int32 Weights[4] = { 0, 1, 6, 40 };
+
+	const int32 Side = Board.GetSideToMove();
+	const uint64 Own = Board.Marks[Side];
+	const uint64 Other = Board.Marks[Side ^ 1];
+
+	int32 Score = 0;
+	for (uint64 Line : GetQubicLines().Lines)
+	{
+		const uint64 OwnInLine = Own & Line;
+		const uint64 OtherInLine = Other & Line;
+		if (!OtherInLine)
+		{
+			Score += Weights[FMath::CountBits(OwnInLine)];
+		}
+		else if (!OwnInLine)
+		{
+			Score -= Weights[FMath::CountBits(OtherInLine)];
+		}
+	}
+	return Score;
+}
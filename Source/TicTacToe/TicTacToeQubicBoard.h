@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeAI.h"
+
+/**
+ * 4x4x4 (Qubic) rules core. Each player's marks fit one uint64 with bit
+ * (Layer * 16 + Row * 4 + Column) per cell, and a win is any of the 76 lines of four.
+ * Only the 4 or 7 lines through the last move are tested after each move.
+ */
+struct TICTACTOE_API FTicTacToeQubicBoard
+{
+	FTicTacToeQubicBoard();
+
+	/** Clear all marks, Player 1 to move */
+	void Reset();
+
+	/** Claim an empty cell for the side to move and update the result */
+	void MakeMove(int32 Cell);
+
+	/** Take back a move previously made on Cell */
+	void UndoMove(int32 Cell);
+
+	/** Does Player own a full line through Cell? */
+	bool IsWinThrough(int32 Cell, int32 Player) const;
+
+	/** Cells that would complete a line for Player */
+	uint64 GetThreats(int32 Player) const;
+
+	FORCEINLINE uint64 GetEmptyMask() const { return ~(Marks[0] | Marks[1]); }
+
+	FORCEINLINE bool IsEmpty(int32 Cell) const { return (GetEmptyMask() >> Cell) & 1; }
+
+	FORCEINLINE int32 GetSideToMove() const { return MoveCount & 1; }
+
+	FORCEINLINE bool IsGameOver() const { return Result != ETicTacToeResult::InProgress; }
+
+	/** All 76 winning lines as cell masks */
+	static const TArray<uint64>& GetLines();
+
+	/** Number of cells */
+	static constexpr int32 NumCells = 64;
+
+	/** Claimed cells per player */
+	uint64 Marks[2];
+
+	/** Moves played so far */
+	int32 MoveCount;
+
+	/** Result after the last move */
+	ETicTacToeResult Result;
+};
+
+/** Alpha-beta player for Qubic with forced-move pruning and a transposition table */
+class TICTACTOE_API FTicTacToeQubicAI
+{
+public:
+	FTicTacToeQubicAI(int32 InMaxDepth = 8, double InTimeLimit = 0.5);
+
+	/** Returns the chosen cell. Board must not be game over. */
+	int32 ChooseMove(const FTicTacToeQubicBoard& Board, FRandomStream& Random, FTicTacToeSearchStats& OutStats);
+
+	/** Deepest iteration to search */
+	int32 MaxDepth;
+
+	/** Seconds per move, 0 for none. An unfinished iteration is abandoned when it runs out. */
+	double TimeLimit;
+
+	/** Optional deadline, stop flag and progress reporting */
+	const FTicTacToeSearchControl* Control;
+
+private:
+
+	struct FEntry
+	{
+		uint64 Marks[2];
+		int32 Score;
+		int8 Depth;
+		int8 Bound;
+		int8 BestCell;
+	};
+
+	/** Transposition table, indexed by the high bits of the position hash */
+	TArray<FEntry> Table;
+
+	/** Wall clock time the current search must stop by */
+	double Deadline;
+
+	/** Set once the deadline passes, unwinding the search */
+	bool bAborted;
+
+	int32 Negamax(FTicTacToeQubicBoard& Board, int32 Depth, int32 Alpha, int32 Beta, int32 Ply, FTicTacToeSearchStats& OutStats);
+
+	/** Line of play from FirstCell through the table's best moves */
+	void GetPrincipalVariation(FTicTacToeQubicBoard Board, int32 FirstCell, int32 MaxLength, TArray<int32>& OutCells) const;
+
+	static int32 Evaluate(const FTicTacToeQubicBoard& Board);
+};
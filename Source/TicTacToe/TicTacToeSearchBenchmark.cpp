@@ -0,0 +1,99 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeSearchBenchmark.h"
+#include "HAL/PlatformTime.h"
+
+FTicTacToeSearchBenchmark::FTicTacToeSearchBenchmark(const FTicTacToeBenchmarkSettings& InSettings)
+	: Settings(InSettings)
+{
+}
+
+TArray<FTicTacToeBoard> FTicTacToeSearchBenchmark::MakePositions(int32 TargetIndex) const
+{
+	const FTicTacToeBenchmarkTarget& Target = Settings.Targets[TargetIndex];
+	FRandomStream Random(HashCombine(GetTypeHash(Settings.Seed), GetTypeHash(TargetIndex)));
+
+	TArray<FTicTacToeBoard> Positions;
+	while (Positions.Num() < Settings.PositionsPerTarget)
+	{
+		FTicTacToeBoard Board(Target.Size, Target.WinLength);
+		for (int32 Move = 0; Move < Settings.OpeningMoves && !Board.IsGameOver(); Move++)
+		{
+			Board.MakeMove(FTicTacToeEngine::RandomCell(Board.GetEmptyMask(), Random));
+		}
+
+		if (!Board.IsGameOver())
+		{
+			Positions.Add(Board);
+		}
+	}
+	return Positions;
+}
+
+void FTicTacToeSearchBenchmark::Run()
+{
+	Reports.Reset();
+
+	for (int32 TargetIndex = 0; TargetIndex < Settings.Targets.Num(); TargetIndex++)
+	{
+		const FTicTacToeBenchmarkTarget& Target = Settings.Targets[TargetIndex];
+		const TArray<FTicTacToeBoard> Positions = MakePositions(TargetIndex);
+
+		TArray<int32> BaselineMoves;
+		double BaselineSeconds = 0.0;
+		for (int32 ThreadIndex = 0; ThreadIndex < Settings.ThreadCounts.Num(); ThreadIndex++)
+		{
+			FTicTacToeBenchmarkReport& Report = Reports.AddDefaulted_GetRef();
+			Report.Target = Target;
+			Report.Threads = Settings.ThreadCounts[ThreadIndex];
+			Report.Positions = Positions.Num();
+
+			FTicTacToeEngineSettings EngineSettings;
+			EngineSettings.Type = ETicTacToeEngineType::LazySMP;
+			EngineSettings.MaxDepth = Target.Depth;
+			EngineSettings.Threads = Report.Threads;
+
+			for (int32 PositionIndex = 0; PositionIndex < Positions.Num(); PositionIndex++)
+			{
+				// A new engine per position so no thread count profits from a warm table
+				TUniquePtr<FTicTacToeEngine> Engine = FTicTacToeEngine::Create(EngineSettings);
+				FRandomStream Random(PositionIndex);
+				FTicTacToeSearchStats Stats;
+
+				const double StartTime = FPlatformTime::Seconds();
+				const int32 Move = Engine->ChooseMove(Positions[PositionIndex], Random, Stats);
+				Report.Seconds += FPlatformTime::Seconds() - StartTime;
+				Report.Nodes += Stats.Nodes;
+
+				if (ThreadIndex == 0)
+				{
+					BaselineMoves.Add(Move);
+				}
+				if (Move == BaselineMoves[PositionIndex])
+				{
+					Report.SameMoves++;
+				}
+			}
+
+			if (ThreadIndex == 0)
+			{
+				BaselineSeconds = Report.Seconds;
+			}
+			Report.Speedup = Report.Seconds > 0.0 ? BaselineSeconds / Report.Seconds : 0.0;
+		}
+	}
+}
+
+FString FTicTacToeSearchBenchmark::FormatReport() const
+{
+	FString Output = FString::Printf(TEXT("%-16s %6s %8s %10s %14s %14s %8s %10s\n"),
+		TEXT("Board"), TEXT("Depth"), TEXT("Threads"), TEXT("Seconds"), TEXT("Nodes"), TEXT("Nodes/sec"), TEXT("Speedup"), TEXT("Same move"));
+
+	for (const FTicTacToeBenchmarkReport& Report : Reports)
+	{
+		const FString Board = FString::Printf(TEXT("%dx%d, %d in a row"), Report.Target.Size, Report.Target.Size, Report.Target.WinLength);
+		Output += FString::Printf(TEXT("%-16s %6d %8d %10.3f %14lld %14.0f %8.2f %7d/%-2d\n"),
+			*Board, Report.Target.Depth, Report.Threads, Report.Seconds, Report.Nodes, Report.GetNodesPerSecond(), Report.Speedup, Report.SameMoves, Report.Positions);
+	}
+	return Output;
+}
@@ -0,0 +1,100 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeAI.h"
+
+/** One board shape and search depth to time */
+struct TICTACTOE_API FTicTacToeBenchmarkTarget
+{
+	FTicTacToeBenchmarkTarget(int32 InSize = 5, int32 InWinLength = 4, int32 InDepth = 9)
+		: Size(InSize)
+		, WinLength(InWinLength)
+		, Depth(InDepth)
+	{
+	}
+
+	int32 Size;
+	int32 WinLength;
+
+	/** Depth every position is searched to */
+	int32 Depth;
+};
+
+struct TICTACTOE_API FTicTacToeBenchmarkSettings
+{
+	FTicTacToeBenchmarkSettings()
+		: PositionsPerTarget(8)
+		, OpeningMoves(2)
+		, Seed(0)
+	{
+		Targets.Add(FTicTacToeBenchmarkTarget(5, 4, 9));
+		Targets.Add(FTicTacToeBenchmarkTarget(7, 5, 7));
+		ThreadCounts = { 1, 2, 4, 8, 16 };
+	}
+
+	TArray<FTicTacToeBenchmarkTarget> Targets;
+
+	/** Lazy SMP thread counts to compare, speedups are relative to the first */
+	TArray<int32> ThreadCounts;
+
+	/** Positions searched per target, each with a cold transposition table */
+	int32 PositionsPerTarget;
+
+	/** Random moves played to make each position */
+	int32 OpeningMoves;
+
+	/** Positions are reproducible from it */
+	int32 Seed;
+};
+
+/** Timing of one target at one thread count */
+struct TICTACTOE_API FTicTacToeBenchmarkReport
+{
+	FTicTacToeBenchmarkReport() : Threads(0), Seconds(0.0), Nodes(0), Speedup(0.0), SameMoves(0), Positions(0) { }
+
+	FTicTacToeBenchmarkTarget Target;
+
+	int32 Threads;
+
+	/** Wall clock time to reach the target depth, summed over the positions */
+	double Seconds;
+
+	/** Nodes searched by all threads */
+	int64 Nodes;
+
+	/** Time at the first thread count divided by this time */
+	double Speedup;
+
+	/** Positions where the chosen move matches the first thread count's */
+	int32 SameMoves;
+	int32 Positions;
+
+	FORCEINLINE double GetNodesPerSecond() const { return Seconds > 0.0 ? Nodes / Seconds : 0.0; }
+};
+
+/** Times the Lazy SMP search to a fixed depth at several thread counts */
+class TICTACTOE_API FTicTacToeSearchBenchmark
+{
+public:
+	explicit FTicTacToeSearchBenchmark(const FTicTacToeBenchmarkSettings& InSettings);
+
+	/** Runs every target at every thread count, blocking until done */
+	void Run();
+
+	/** One report per target and thread count, valid after Run */
+	FORCEINLINE const TArray<FTicTacToeBenchmarkReport>& GetReports() const { return Reports; }
+
+	/** Human readable table of the reports */
+	FString FormatReport() const;
+
+private:
+
+	/** Reproducible non-terminal positions for a target */
+	TArray<FTicTacToeBoard> MakePositions(int32 TargetIndex) const;
+
+	FTicTacToeBenchmarkSettings Settings;
+
+	TArray<FTicTacToeBenchmarkReport> Reports;
+};
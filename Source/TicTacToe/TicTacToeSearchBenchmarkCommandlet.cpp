@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeSearchBenchmarkCommandlet.h"
+#include "TicTacToe.h"
+#include "TicTacToeSearchBenchmark.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+
+UTicTacToeSearchBenchmarkCommandlet::UTicTacToeSearchBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTicTacToeSearchBenchmarkCommandlet::Main(const FString& Params)
+{
+	FTicTacToeBenchmarkSettings Settings;
+
+	FString ThreadList;
+	if (FParse::Value(*Params, TEXT("Threads="), ThreadList, false))
+	{
+		TArray<FString> Counts;
+		ThreadList.ParseIntoArray(Counts, TEXT(","));
+		Settings.ThreadCounts.Reset();
+		for (const FString& Count : Counts)
+		{
+			Settings.ThreadCounts.Add(FMath::Max(1, FCString::Atoi(*Count)));
+		}
+	}
+
+	if (Settings.ThreadCounts.Num() == 0)
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("No thread counts to benchmark"));
+		return 1;
+	}
+
+	int32 Size = 0;
+	if (FParse::Value(*Params, TEXT("Size="), Size))
+	{
+		FTicTacToeBenchmarkTarget Target;
+		Target.Size = FMath::Clamp(Size, 3, FTicTacToeLineTable::MaxSize);
+		FParse::Value(*Params, TEXT("WinLength="), Target.WinLength);
+		FParse::Value(*Params, TEXT("Depth="), Target.Depth);
+		Target.WinLength = FMath::Clamp(Target.WinLength, 3, Target.Size);
+		Target.Depth = FMath::Max(1, Target.Depth);
+
+		Settings.Targets.Reset();
+		Settings.Targets.Add(Target);
+	}
+
+	FParse::Value(*Params, TEXT("Positions="), Settings.PositionsPerTarget);
+	FParse::Value(*Params, TEXT("Openings="), Settings.OpeningMoves);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+
+	// Speedups above the core count measure scheduling, not search
+	UE_LOG(LogTicTacToe, Display, TEXT("Search benchmark: %d targets, %d positions each, %d logical cores, seed %d"),
+		Settings.Targets.Num(), Settings.PositionsPerTarget, FPlatformMisc::NumberOfCoresIncludingHyperthreads(), Settings.Seed);
+
+	const double StartTime = FPlatformTime::Seconds();
+	FTicTacToeSearchBenchmark Benchmark(Settings);
+	Benchmark.Run();
+
+	UE_LOG(LogTicTacToe, Display, TEXT("Finished in %.2f s\n%s"), FPlatformTime::Seconds() - StartTime, *Benchmark.FormatReport());
+	return 0;
+}
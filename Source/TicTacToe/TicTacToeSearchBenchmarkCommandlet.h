@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TicTacToeSearchBenchmarkCommandlet.generated.h"
+
+/**
+ * Times the Lazy SMP search to a fixed depth at several thread counts and logs the speedups.
+ * Without -Size the default 5x5 and 7x7 targets are run.
+ *
+ * UE4Editor-Cmd TicTacToe -run=TicTacToeSearchBenchmark [-Threads=1,2,4,8,16]
+ *     [-Size=5 -WinLength=4 -Depth=9] [-Positions=8] [-Openings=2] [-Seed=0]
+ */
+UCLASS()
+class UTicTacToeSearchBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTicTacToeSearchBenchmarkCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
@@ -0,0 +1,128 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeSearchLibrary.h"
+#include "TicTacToeAnytimeSearch.h"
+#include "TicTacToeBlockGrid.h"
+#include "Engine/Engine.h"
+#include "LatentActions.h"
+
+namespace
+{
+	/** Polls an anytime search once per frame and writes its results to the Blueprint's output pins */
+	class FTicTacToeFindBestMoveAction : public FPendingLatentAction
+	{
+	public:
+		FTicTacToeFindBestMoveAction(const TSharedRef<FTicTacToeAnytimeSearch, ESPMode::ThreadSafe>& InSearch, const FLatentActionInfo& LatentInfo,
+			ETicTacToeSearchOutput& InOutput, int32& InBestBlock, int32& InDepth, int64& InNodes, TArray<int32>& InPrincipalVariation)
+			: Search(InSearch)
+			, ExecutionFunction(LatentInfo.ExecutionFunction)
+			, OutputLink(LatentInfo.Linkage)
+			, CallbackTarget(LatentInfo.CallbackTarget)
+			, Output(InOutput)
+			, BestBlock(InBestBlock)
+			, Depth(InDepth)
+			, Nodes(InNodes)
+			, PrincipalVariation(InPrincipalVariation)
+			, ProgressCount(0)
+		{
+		}
+
+		virtual ~FTicTacToeFindBestMoveAction()
+		{
+			Search->Cancel();
+		}
+
+		virtual void UpdateOperation(FLatentResponse& Response) override
+		{
+			// Checked first so a final report is never mistaken for progress
+			const bool bComplete = Search->IsComplete();
+			const int32 Count = Search->GetProgressCount();
+			if (!bComplete && Count == ProgressCount)
+				return;
+
+			ProgressCount = Count;
+			WriteOutputs();
+
+			if (bComplete)
+			{
+				Output = ETicTacToeSearchOutput::Completed;
+				Response.FinishAndTriggerIf(true, ExecutionFunction, OutputLink, CallbackTarget);
+			}
+			else
+			{
+				Output = ETicTacToeSearchOutput::Progress;
+				Response.TriggerLink(ExecutionFunction, OutputLink, CallbackTarget);
+			}
+		}
+
+		virtual void NotifyObjectDestroyed() override
+		{
+			Search->Cancel();
+		}
+
+		virtual void NotifyActionAborted() override
+		{
+			Search->Cancel();
+		}
+
+#if WITH_EDITOR
+		virtual FString GetDescription() const override
+		{
+			const FTicTacToeSearchProgress Progress = Search->GetProgress();
+			return FString::Printf(TEXT("Searching depth %d, %lld nodes"), Progress.Depth, Progress.Nodes);
+		}
+#endif
+
+	private:
+
+		void WriteOutputs()
+		{
+			const FTicTacToeSearchProgress Progress = Search->GetProgress();
+			BestBlock = Progress.BestMove;
+			Depth = Progress.Depth;
+			Nodes = Progress.Nodes;
+			PrincipalVariation = Progress.PrincipalVariation;
+		}
+
+		TSharedRef<FTicTacToeAnytimeSearch, ESPMode::ThreadSafe> Search;
+
+		FName ExecutionFunction;
+		int32 OutputLink;
+		FWeakObjectPtr CallbackTarget;
+
+		/** Output pins in the calling Blueprint's frame */
+		ETicTacToeSearchOutput& Output;
+		int32& BestBlock;
+		int32& Depth;
+		int64& Nodes;
+		TArray<int32>& PrincipalVariation;
+
+		/** Reports already passed on */
+		int32 ProgressCount;
+	};
+}
+
+void UTicTacToeSearchLibrary::FindBestMove(UObject* WorldContextObject, ATicTacToeBlockGrid* Grid, float TimeLimit, ETicTacToeSearchOutput& Output,
+	int32& BestBlock, int32& Depth, int64& Nodes, TArray<int32>& PrincipalVariation, FLatentActionInfo LatentInfo)
+{
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	if (World == nullptr || Grid == nullptr)
+		return;
+
+	// One search per node at a time, a second call while one is running is ignored
+	FLatentActionManager& LatentManager = World->GetLatentActionManager();
+	if (LatentManager.FindExistingAction<FTicTacToeFindBestMoveAction>(LatentInfo.CallbackTarget, LatentInfo.UUID) != nullptr)
+		return;
+
+	BestBlock = INDEX_NONE;
+	Depth = 0;
+	Nodes = 0;
+	PrincipalVariation.Reset();
+
+	TSharedRef<FTicTacToeAnytimeSearch, ESPMode::ThreadSafe> Search = MakeShared<FTicTacToeAnytimeSearch, ESPMode::ThreadSafe>(
+		Grid->GetPosition(), Grid->GetAISettings(), FMath::Max(TimeLimit, 0.f), FMath::Rand());
+	Search->RunAsync();
+
+	LatentManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID,
+		new FTicTacToeFindBestMoveAction(Search, LatentInfo, Output, BestBlock, Depth, Nodes, PrincipalVariation));
+}
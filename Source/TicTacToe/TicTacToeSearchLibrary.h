@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Engine/LatentActionManager.h"
+#include "TicTacToeSearchLibrary.generated.h"
+
+/** Output pins of FindBestMove */
+UENUM(BlueprintType)
+enum class ETicTacToeSearchOutput : uint8
+{
+	/** A deeper iteration finished, fired at most once per frame */
+	Progress,
+	/** The search finished or ran out of time, BestBlock is final */
+	Completed
+};
+
+/** Blueprint access to the AI search */
+UCLASS()
+class UTicTacToeSearchLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+
+	/**
+	 * Searches for the best move in the grid's current game on a pool thread, never blocking the frame.
+	 * Completes within TimeLimit seconds with the best block found so far.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TicTacToe|AI", meta = (Latent, LatentInfo = "LatentInfo", WorldContext = "WorldContextObject", ExpandEnumAsExecs = "Output"))
+	static void FindBestMove(UObject* WorldContextObject, class ATicTacToeBlockGrid* Grid, float TimeLimit, ETicTacToeSearchOutput& Output,
+		int32& BestBlock, int32& Depth, int64& Nodes, TArray<int32>& PrincipalVariation, FLatentActionInfo LatentInfo);
+};
@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeSolveCommandlet.h"
+#include "TicTacToe.h"
+#include "TicTacToeProofSolver.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	/** Seconds between progress lines */
+	constexpr double ProgressInterval = 30.0;
+}
+
+UTicTacToeSolveCommandlet::UTicTacToeSolveCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTicTacToeSolveCommandlet::Main(const FString& Params)
+{
+	int32 Size = 5;
+	int32 WinLength = 4;
+	FParse::Value(*Params, TEXT("Size="), Size);
+	FParse::Value(*Params, TEXT("WinLength="), WinLength);
+	Size = FMath::Clamp(Size, 3, FTicTacToeLineTable::MaxSize);
+	WinLength = FMath::Clamp(WinLength, 3, Size);
+
+	FTicTacToeBoard Root(Size, WinLength);
+	FString MoveList;
+	if (FParse::Value(*Params, TEXT("Moves="), MoveList, false))
+	{
+		TArray<FString> Cells;
+		MoveList.ParseIntoArray(Cells, TEXT(","));
+		for (const FString& CellText : Cells)
+		{
+			const int32 Cell = FCString::Atoi(*CellText);
+			if (Cell < 0 || Cell >= Root.NumCells || !Root.IsEmpty(Cell) || Root.IsGameOver())
+			{
+				UE_LOG(LogTicTacToe, Error, TEXT("Illegal opening move %s"), *CellText);
+				return 1;
+			}
+			Root.MakeMove(Cell);
+		}
+	}
+
+	int32 MemoryMB = 256;
+	double CheckpointMinutes = 10.0;
+	double Hours = 0.0;
+	FParse::Value(*Params, TEXT("Memory="), MemoryMB);
+	FParse::Value(*Params, TEXT("CheckpointMinutes="), CheckpointMinutes);
+	FParse::Value(*Params, TEXT("Hours="), Hours);
+
+	FString Checkpoint = FPaths::ProjectSavedDir() / TEXT("Solver") / FString::Printf(TEXT("Solve_%dx%d_%d.bin"), Size, Size, WinLength);
+	FParse::Value(*Params, TEXT("Checkpoint="), Checkpoint);
+
+	FTicTacToeProofSolver Solver(Root, MemoryMB);
+	if (FParse::Param(*Params, TEXT("Resume")))
+	{
+		if (!Solver.LoadCheckpoint(Checkpoint))
+		{
+			UE_LOG(LogTicTacToe, Error, TEXT("Cannot resume from '%s', it is missing or for another position"), *Checkpoint);
+			return 1;
+		}
+		UE_LOG(LogTicTacToe, Display, TEXT("Resumed from '%s' after %lld nodes, %lld positions loaded"),
+			*Checkpoint, Solver.GetStats().Nodes, Solver.GetNumEntries());
+	}
+
+	UE_LOG(LogTicTacToe, Display, TEXT("Solving %dx%d, %d in a row, after %d moves: %lld table entries, checkpoint '%s'"),
+		Size, Size, WinLength, Root.MoveCount, Solver.GetCapacity(), *Checkpoint);
+
+	// Zero hours runs until solved
+	const double StartTime = FPlatformTime::Seconds();
+	const double StopTime = Hours > 0.0 ? StartTime + Hours * 3600.0 : MAX_dbl;
+	double NextCheckpoint = StartTime + CheckpointMinutes * 60.0;
+	bool bSolved = false;
+	while (!bSolved)
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (Now >= StopTime)
+			break;
+
+		bSolved = Solver.Run(FMath::Min(ProgressInterval, FMath::Min(NextCheckpoint, StopTime) - Now));
+
+		const FTicTacToeProofStats& Stats = Solver.GetStats();
+		UE_LOG(LogTicTacToe, Display, TEXT("%12lld nodes  %8.0f nodes/sec  proof %10u  disproof %10u  table %5.1f%%  %d collections"),
+			Stats.Nodes, Stats.Nodes / FMath::Max(Stats.Seconds, 1e-6), Stats.ProofNumber, Stats.DisproofNumber,
+			100.0 * Solver.GetNumEntries() / Solver.GetCapacity(), Stats.GarbageCollections);
+
+		if (!bSolved && FPlatformTime::Seconds() >= NextCheckpoint)
+		{
+			if (!Solver.SaveCheckpoint(Checkpoint))
+			{
+				UE_LOG(LogTicTacToe, Warning, TEXT("Failed to write checkpoint '%s'"), *Checkpoint);
+			}
+			NextCheckpoint = FPlatformTime::Seconds() + CheckpointMinutes * 60.0;
+		}
+	}
+
+	// The final table is kept too, a solved checkpoint records the result
+	if (!Solver.SaveCheckpoint(Checkpoint))
+	{
+		UE_LOG(LogTicTacToe, Warning, TEXT("Failed to write checkpoint '%s'"), *Checkpoint);
+	}
+
+	const bool bFromEmpty = Root.MoveCount == 0;
+	const TCHAR* Side = Root.GetSideToMove() == 0 ? TEXT("Player 1") : TEXT("Player 2");
+	switch (Solver.GetResult())
+	{
+	case ETicTacToeProofResult::Win:
+		UE_LOG(LogTicTacToe, Display, TEXT("Proved: %s to move wins, %.1f s over all runs"), Side, Solver.GetStats().Seconds);
+		break;
+	case ETicTacToeProofResult::NoWin:
+		UE_LOG(LogTicTacToe, Display, TEXT("Proved: %s, %.1f s over all runs"),
+			bFromEmpty ? TEXT("draw") : *FString::Printf(TEXT("%s to move cannot force a win"), Side), Solver.GetStats().Seconds);
+		break;
+	default:
+		UE_LOG(LogTicTacToe, Display, TEXT("Stopped unsolved, resume with -Resume"));
+		break;
+	}
+	return 0;
+}
@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TicTacToeSolveCommandlet.generated.h"
+
+/**
+ * Proves the outcome of a Classic board with the df-pn solver, from the empty board or after the
+ * given opening cells. The solver's table is checkpointed to disk every few minutes and -Resume
+ * carries on from the checkpoint, so a solve can be stopped and restarted across sessions.
+ *
+ * UE4Editor-Cmd TicTacToe -run=TicTacToeSolve -Size=5 -WinLength=4 [-Moves=12,6] [-Memory=256]
+ *     [-Checkpoint=Path] [-CheckpointMinutes=10] [-Hours=0] [-Resume]
+ */
+UCLASS()
+class UTicTacToeSolveCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTicTacToeSolveCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
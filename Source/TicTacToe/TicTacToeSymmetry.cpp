@@ -0,0 +1,248 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeSymmetry.h"
+
+namespace
+{
+	/** Swaps the bits selected by Mask with the bits Shift places above them */
+	FORCEINLINE uint64 DeltaSwap(uint64 Bits, uint64 Mask, int32 Shift)
+	{
+		const uint64 Delta = (Bits ^ (Bits >> Shift)) & Mask;
+		return Bits ^ Delta ^ (Delta << Shift);
+	}
+
+	/** 4x4 mask primitives, one nibble per row */
+	FORCEINLINE uint64 FlipHorizontal4(uint64 Bits)
+	{
+		Bits = DeltaSwap(Bits, 0x5555, 1);
+		return DeltaSwap(Bits, 0x3333, 2);
+	}
+
+	FORCEINLINE uint64 FlipVertical4(uint64 Bits)
+	{
+		Bits = DeltaSwap(Bits, 0x00FF, 8);
+		return DeltaSwap(Bits, 0x0F0F, 4);
+	}
+
+	FORCEINLINE uint64 Transpose4(uint64 Bits)
+	{
+		Bits = DeltaSwap(Bits, 0x0A0A, 3);
+		return DeltaSwap(Bits, 0x00CC, 6);
+	}
+
+	/** 8x8 mask primitives, one byte per row */
+	FORCEINLINE uint64 FlipHorizontal8(uint64 Bits)
+	{
+		Bits = DeltaSwap(Bits, 0x5555555555555555ull, 1);
+		Bits = DeltaSwap(Bits, 0x3333333333333333ull, 2);
+		return DeltaSwap(Bits, 0x0F0F0F0F0F0F0F0Full, 4);
+	}
+
+	FORCEINLINE uint64 FlipVertical8(uint64 Bits)
+	{
+		Bits = DeltaSwap(Bits, 0x00000000FFFFFFFFull, 32);
+		Bits = DeltaSwap(Bits, 0x0000FFFF0000FFFFull, 16);
+		return DeltaSwap(Bits, 0x00FF00FF00FF00FFull, 8);
+	}
+
+	FORCEINLINE uint64 Transpose8(uint64 Bits)
+	{
+		Bits = DeltaSwap(Bits, 0x00AA00AA00AA00AAull, 7);
+		Bits = DeltaSwap(Bits, 0x0000CCCC0000CCCCull, 14);
+		return DeltaSwap(Bits, 0x00000000F0F0F0F0ull, 28);
+	}
+
+	/** Every transform built from the three primitives of one board size */
+	template<uint64 (*FlipHorizontal)(uint64), uint64 (*FlipVertical)(uint64), uint64 (*Transpose)(uint64)>
+	FORCEINLINE uint64 TransformWithSwaps(uint64 Bits, ETicTacToeSymmetry Transform)
+	{
+		switch (Transform)
+		{
+		case ETicTacToeSymmetry::Rotate90:
+			return FlipHorizontal(Transpose(Bits));
+		case ETicTacToeSymmetry::Rotate180:
+			return FlipHorizontal(FlipVertical(Bits));
+		case ETicTacToeSymmetry::Rotate270:
+			return FlipVertical(Transpose(Bits));
+		case ETicTacToeSymmetry::FlipHorizontal:
+			return FlipHorizontal(Bits);
+		case ETicTacToeSymmetry::FlipVertical:
+			return FlipVertical(Bits);
+		case ETicTacToeSymmetry::FlipDiagonal:
+			return Transpose(Bits);
+		case ETicTacToeSymmetry::FlipAntiDiagonal:
+			return FlipHorizontal(FlipVertical(Transpose(Bits)));
+		default:
+			return Bits;
+		}
+	}
+
+	/** Builds the tables of every supported size once, on first use */
+	struct FSymmetrySet
+	{
+		FTicTacToeSymmetry Tables[FTicTacToeLineTable::MaxSize + 1];
+
+		FSymmetrySet()
+		{
+			for (int32 Size = 3; Size <= FTicTacToeLineTable::MaxSize; Size++)
+			{
+				Build(Tables[Size], Size);
+			}
+		}
+
+		static void Build(FTicTacToeSymmetry& Table, int32 Size)
+		{
+			Table.Size = Size;
+
+			const int32 Last = Size - 1;
+			for (int32 Row = 0; Row < Size; Row++)
+			{
+				for (int32 Column = 0; Column < Size; Column++)
+				{
+					// Destination row and column under each transform, in ETicTacToeSymmetry order
+					const int32 Destinations[FTicTacToeSymmetry::NumTransforms][2] =
+					{
+						{ Row, Column },
+						{ Column, Last - Row },
+						{ Last - Row, Last - Column },
+						{ Last - Column, Row },
+						{ Row, Last - Column },
+						{ Last - Row, Column },
+						{ Column, Row },
+						{ Last - Column, Last - Row }
+					};
+
+					for (int32 Transform = 0; Transform < FTicTacToeSymmetry::NumTransforms; Transform++)
+					{
+						Table.CellMaps[Transform][Row * Size + Column] = uint8(Destinations[Transform][0] * Size + Destinations[Transform][1]);
+					}
+				}
+			}
+
+			const int32 NumCells = Size * Size;
+			auto TransformSlowly = [&Table, NumCells](uint64 Mask, int32 Transform)
+			{
+				uint64 Result = 0;
+				for (int32 Cell = 0; Cell < NumCells; Cell++)
+				{
+					if ((Mask >> Cell) & 1)
+					{
+						Result |= 1ull << Table.CellMaps[Transform][Cell];
+					}
+				}
+				return Result;
+			};
+
+			if (Size == 3)
+			{
+				Table.BoardMaps.SetNumUninitialized(FTicTacToeSymmetry::NumTransforms * 512);
+				for (int32 Transform = 0; Transform < FTicTacToeSymmetry::NumTransforms; Transform++)
+				{
+					for (uint32 Mask = 0; Mask < 512; Mask++)
+					{
+						Table.BoardMaps[Transform * 512 + Mask] = uint16(TransformSlowly(Mask, Transform));
+					}
+				}
+			}
+			else if (Size != 4 && Size != 8)
+			{
+				Table.ByteMaps.SetNumUninitialized(FTicTacToeSymmetry::NumTransforms * 8 * 256);
+				for (int32 Transform = 0; Transform < FTicTacToeSymmetry::NumTransforms; Transform++)
+				{
+					for (int32 Byte = 0; Byte < 8; Byte++)
+					{
+						for (uint32 Value = 0; Value < 256; Value++)
+						{
+							const uint64 Mask = (uint64(Value) << (Byte * 8)) & (NumCells == 64 ? ~0ull : (1ull << NumCells) - 1);
+							Table.ByteMaps[(Transform * 8 + Byte) * 256 + Value] = TransformSlowly(Mask, Transform);
+						}
+					}
+				}
+			}
+		}
+	};
+}
+
+const FTicTacToeSymmetry& FTicTacToeSymmetry::Get(int32 Size)
+{
+	static const FSymmetrySet TableSet;
+
+	check(Size >= 3 && Size <= FTicTacToeLineTable::MaxSize);
+	return TableSet.Tables[Size];
+}
+
+uint64 FTicTacToeSymmetry::TransformMask(uint64 Mask, ETicTacToeSymmetry Transform) const
+{
+	switch (Size)
+	{
+	case 3:
+		return BoardMaps[int32(Transform) * 512 + int32(Mask)];
+	case 4:
+		return TransformWithSwaps<FlipHorizontal4, FlipVertical4, Transpose4>(Mask, Transform);
+	case 8:
+		return TransformWithSwaps<FlipHorizontal8, FlipVertical8, Transpose8>(Mask, Transform);
+	default:
+	{
+		// Only the bytes that hold cells, at most 7 for 7x7
+		const uint64* Maps = &ByteMaps[int32(Transform) * 8 * 256];
+		uint64 Result = 0;
+		for (; Mask != 0; Mask >>= 8, Maps += 256)
+		{
+			Result |= Maps[Mask & 0xFF];
+		}
+		return Result;
+	}
+	}
+}
+
+FTicTacToeCanonicalPosition FTicTacToeSymmetry::Canonicalize(const FTicTacToeBoard& Board) const
+{
+	FTicTacToeCanonicalPosition Best;
+	Best.Marks[0] = Board.Marks[0];
+	Best.Marks[1] = Board.Marks[1];
+	Best.Transform = ETicTacToeSymmetry::Identity;
+
+	for (int32 Transform = 1; Transform < NumTransforms; Transform++)
+	{
+		const uint64 First = TransformMask(Board.Marks[0], ETicTacToeSymmetry(Transform));
+		if (First > Best.Marks[0])
+			continue;
+
+		const uint64 Second = TransformMask(Board.Marks[1], ETicTacToeSymmetry(Transform));
+		if (First < Best.Marks[0] || Second < Best.Marks[1])
+		{
+			Best.Marks[0] = First;
+			Best.Marks[1] = Second;
+			Best.Transform = ETicTacToeSymmetry(Transform);
+		}
+	}
+	return Best;
+}
+
+uint32 FTicTacToeSymmetry::GetStabilizer(const FTicTacToeBoard& Board) const
+{
+	uint32 Stabilizer = 1;
+	for (int32 Transform = 1; Transform < NumTransforms; Transform++)
+	{
+		if (TransformMask(Board.Marks[0], ETicTacToeSymmetry(Transform)) == Board.Marks[0]
+			&& TransformMask(Board.Marks[1], ETicTacToeSymmetry(Transform)) == Board.Marks[1])
+		{
+			Stabilizer |= 1u << Transform;
+		}
+	}
+	return Stabilizer;
+}
+
+ETicTacToeSymmetry FTicTacToeSymmetry::GetInverse(ETicTacToeSymmetry Transform)
+{
+	// Only the quarter turns are not their own inverse
+	switch (Transform)
+	{
+	case ETicTacToeSymmetry::Rotate90:
+		return ETicTacToeSymmetry::Rotate270;
+	case ETicTacToeSymmetry::Rotate270:
+		return ETicTacToeSymmetry::Rotate90;
+	default:
+		return Transform;
+	}
+}
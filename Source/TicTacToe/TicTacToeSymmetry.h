@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeBoard.h"
+
+/** The eight rotations and reflections of a square board */
+enum class ETicTacToeSymmetry : uint8
+{
+	Identity,
+	/** Clockwise quarter turn */
+	Rotate90,
+	Rotate180,
+	Rotate270,
+	/** Mirror left to right */
+	FlipHorizontal,
+	/** Mirror top to bottom */
+	FlipVertical,
+	/** Mirror in the top-left to bottom-right diagonal */
+	FlipDiagonal,
+	/** Mirror in the top-right to bottom-left diagonal */
+	FlipAntiDiagonal,
+
+	Count
+};
+
+/** A Classic position turned to its canonical orientation */
+struct FTicTacToeCanonicalPosition
+{
+	/** Claimed cells per player after the transform */
+	uint64 Marks[2];
+
+	/** Transform taking the original position to this one */
+	ETicTacToeSymmetry Transform;
+
+	/** Same key for every orientation of a position, see FTicTacToeBoard::GetKey */
+	FORCEINLINE uint64 GetKey() const { return Marks[0] * 0x9E3779B97F4A7C15ull ^ Marks[1] * 0xC2B2AE3D27D4EB4Full; }
+};
+
+/**
+ * Folds the dihedral symmetries of one board size. Cell masks are transformed with precomputed
+ * tables: a whole-board lookup for 3x3, delta swaps for 4x4 and 8x8 and per-byte lookups otherwise,
+ * so canonicalizing costs a few dozen operations and is cheap enough to do at every search node.
+ */
+struct TICTACTOE_API FTicTacToeSymmetry
+{
+	/** Returns the shared tables for a board size, 3..8 */
+	static const FTicTacToeSymmetry& Get(int32 Size);
+
+	/** Moves every bit of a cell mask to its transformed cell */
+	uint64 TransformMask(uint64 Mask, ETicTacToeSymmetry Transform) const;
+
+	FORCEINLINE int32 TransformCell(int32 Cell, ETicTacToeSymmetry Transform) const { return CellMaps[int32(Transform)][Cell]; }
+
+	/** The position with the smallest marks over all eight orientations */
+	FTicTacToeCanonicalPosition Canonicalize(const FTicTacToeBoard& Board) const;
+
+	/** Bit per transform that maps the position onto itself, always including Identity */
+	uint32 GetStabilizer(const FTicTacToeBoard& Board) const;
+
+	/** Transform undoing Transform */
+	static ETicTacToeSymmetry GetInverse(ETicTacToeSymmetry Transform);
+
+	static constexpr int32 NumTransforms = int32(ETicTacToeSymmetry::Count);
+
+	/** Number of cells along each side */
+	int32 Size;
+
+	/** Destination of every cell under every transform */
+	uint8 CellMaps[NumTransforms][64];
+
+	/** 3x3 only, transformed mask of every 9 bit mask, indexed Transform * 512 + Mask */
+	TArray<uint16> BoardMaps;
+
+	/** 5x5 to 7x7 only, transformed bits of each byte of a mask, indexed (Transform * 8 + Byte) * 256 + Value */
+	TArray<uint64> ByteMaps;
+};
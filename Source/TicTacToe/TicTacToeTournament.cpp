@@ -0,0 +1,231 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeTournament.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+
+FTicTacToeTournament::FTicTacToeTournament(const FTicTacToeTournamentSettings& InSettings)
+	: Settings(InSettings)
+{
+	Settings.GamesPerBatch = FMath::Max(1, Settings.GamesPerBatch);
+}
+
+void FTicTacToeTournament::Run()
+{
+	ScheduleBatches();
+
+	// Batches are independent, so the schedule spreads across every worker thread
+	ParallelFor(Batches.Num(), [this](int32 BatchIndex)
+	{
+		PlayBatch(Batches[BatchIndex]);
+	});
+
+	ComputeRatings();
+}
+
+void FTicTacToeTournament::ScheduleBatches()
+{
+	Batches.Reset();
+
+	// Who moves first under WinnerMovesFirst follows from every earlier game, so those pairings cannot be split
+	const int32 GamesPerBatch = Settings.FirstMoveRule == ETicTacToeFirstMoveRule::WinnerMovesFirst
+		? FMath::Max(1, Settings.GamesPerPairing) : Settings.GamesPerBatch;
+
+	const int32 NumEngines = Settings.Engines.Num();
+	int32 PairingIndex = 0;
+	for (int32 EngineA = 0; EngineA < NumEngines; EngineA++)
+	{
+		for (int32 EngineB = EngineA + 1; EngineB < NumEngines; EngineB++)
+		{
+			if (Settings.Format == ETicTacToeTournamentFormat::Gauntlet && EngineA != 0)
+				continue;
+
+			int32 BatchIndex = 0;
+			for (int32 GamesLeft = Settings.GamesPerPairing; GamesLeft > 0; GamesLeft -= GamesPerBatch)
+			{
+				FBatch& Batch = Batches.AddZeroed_GetRef();
+				Batch.EngineA = EngineA;
+				Batch.EngineB = EngineB;
+				Batch.PairingIndex = PairingIndex;
+				Batch.BatchIndex = BatchIndex++;
+				Batch.NumGames = FMath::Min(GamesLeft, GamesPerBatch);
+			}
+			PairingIndex++;
+		}
+	}
+}
+
+void FTicTacToeTournament::PlayBatch(FBatch& Batch) const
+{
+	FRandomStream Random(HashCombine(HashCombine(GetTypeHash(Settings.Seed), GetTypeHash(Batch.PairingIndex)), GetTypeHash(Batch.BatchIndex)));
+
+	TUniquePtr<FTicTacToeEngine> Engines[2] =
+	{
+		FTicTacToeEngine::Create(Settings.Engines[Batch.EngineA]),
+		FTicTacToeEngine::Create(Settings.Engines[Batch.EngineB])
+	};
+
+	// Index into Engines of whoever plays as Player 1 in the next game
+	int32 FirstEngine = (Batch.BatchIndex * Settings.GamesPerBatch) & 1;
+
+	FTicTacToeBoard Board(Settings.BoardSize, Settings.WinLength);
+	for (int32 Game = 0; Game < Batch.NumGames; Game++)
+	{
+		Board.Reset();
+		while (!Board.IsGameOver())
+		{
+			const int32 Mover = FirstEngine ^ Board.GetSideToMove();
+
+			FTicTacToeSearchStats Stats;
+			const double StartTime = FPlatformTime::Seconds();
+			const int32 Cell = Engines[Mover]->ChooseMove(Board, Random, Stats);
+			Batch.SearchSeconds[Mover] += FPlatformTime::Seconds() - StartTime;
+			Batch.Nodes[Mover] += Stats.Nodes;
+			Batch.Moves[Mover]++;
+
+			Board.MakeMove(Cell);
+		}
+
+		if (Board.Result == ETicTacToeResult::Draw)
+		{
+			Batch.Draws++;
+		}
+		else
+		{
+			const int32 Winner = FirstEngine ^ (Board.Result == ETicTacToeResult::Player1Win ? 0 : 1);
+			(Winner == 0 ? Batch.WinsA : Batch.WinsB)++;
+		}
+
+		switch (Settings.FirstMoveRule)
+		{
+		case ETicTacToeFirstMoveRule::Alternate:
+			FirstEngine ^= 1;
+			break;
+		case ETicTacToeFirstMoveRule::WinnerMovesFirst:
+			// The grid keeps switching turns through a draw, so whoever would have moved next starts
+			if (Board.Result == ETicTacToeResult::Draw)
+				FirstEngine ^= Board.GetSideToMove();
+			else
+				FirstEngine ^= Board.Result == ETicTacToeResult::Player1Win ? 0 : 1;
+			break;
+		}
+	}
+}
+
+void FTicTacToeTournament::ComputeRatings()
+{
+	const int32 NumEngines = Settings.Engines.Num();
+
+	Reports.Reset();
+	Reports.SetNum(NumEngines);
+	for (int32 Engine = 0; Engine < NumEngines; Engine++)
+	{
+		Reports[Engine].Name = Settings.Engines[Engine].Name;
+	}
+
+	// Games and points scored for each ordered pair
+	TArray<double> Games, Points;
+	Games.SetNumZeroed(NumEngines * NumEngines);
+	Points.SetNumZeroed(NumEngines * NumEngines);
+
+	for (const FBatch& Batch : Batches)
+	{
+		const int32 Sides[2] = { Batch.EngineA, Batch.EngineB };
+		const int32 Wins[2] = { Batch.WinsA, Batch.WinsB };
+		for (int32 Side = 0; Side < 2; Side++)
+		{
+			FTicTacToeEngineReport& Report = Reports[Sides[Side]];
+			Report.Games += Batch.NumGames;
+			Report.Wins += Wins[Side];
+			Report.Losses += Wins[Side ^ 1];
+			Report.Draws += Batch.Draws;
+			Report.Moves += Batch.Moves[Side];
+			Report.Nodes += Batch.Nodes[Side];
+			Report.SearchSeconds += Batch.SearchSeconds[Side];
+
+			Games[Sides[Side] * NumEngines + Sides[Side ^ 1]] += Batch.NumGames;
+			Points[Sides[Side] * NumEngines + Sides[Side ^ 1]] += Wins[Side] + 0.5 * Batch.Draws;
+		}
+	}
+
+	// One virtual draw per pairing keeps perfect scores at a finite rating
+	for (int32 Index = 0; Index < Games.Num(); Index++)
+	{
+		if (Games[Index] > 0.0)
+		{
+			Games[Index] += 1.0;
+			Points[Index] += 0.5;
+		}
+	}
+
+	// Bradley-Terry maximum likelihood by per-engine Newton steps on the Elo logistic curve
+	const double EloScale = 400.0 / FMath::Loge(10.0);
+	TArray<double> Information;
+	Information.SetNumZeroed(NumEngines);
+	for (int32 Iteration = 0; Iteration < 200; Iteration++)
+	{
+		double LargestStep = 0.0;
+		for (int32 Engine = 0; Engine < NumEngines; Engine++)
+		{
+			double Expected = 0.0, Scored = 0.0;
+			Information[Engine] = 0.0;
+			for (int32 Opponent = 0; Opponent < NumEngines; Opponent++)
+			{
+				const double PairGames = Games[Engine * NumEngines + Opponent];
+				if (PairGames <= 0.0)
+					continue;
+
+				const double Probability = 1.0 / (1.0 + FMath::Pow(10.0, (Reports[Opponent].Elo - Reports[Engine].Elo) / 400.0));
+				Expected += PairGames * Probability;
+				Scored += Points[Engine * NumEngines + Opponent];
+				Information[Engine] += PairGames * Probability * (1.0 - Probability);
+			}
+
+			if (Information[Engine] > 0.0)
+			{
+				const double Step = EloScale * (Scored - Expected) / Information[Engine];
+				Reports[Engine].Elo += Step;
+				LargestStep = FMath::Max(LargestStep, FMath::Abs(Step));
+			}
+		}
+
+		double MeanElo = 0.0;
+		for (const FTicTacToeEngineReport& Report : Reports)
+		{
+			MeanElo += Report.Elo / NumEngines;
+		}
+		for (FTicTacToeEngineReport& Report : Reports)
+		{
+			Report.Elo -= MeanElo;
+		}
+
+		if (LargestStep < 0.01)
+			break;
+	}
+
+	for (int32 Engine = 0; Engine < NumEngines; Engine++)
+	{
+		Reports[Engine].EloMargin = Information[Engine] > 0.0 ? 1.96 * EloScale / FMath::Sqrt(Information[Engine]) : 0.0;
+	}
+}
+
+FString FTicTacToeTournament::FormatReport() const
+{
+	TArray<const FTicTacToeEngineReport*> Ranked;
+	for (const FTicTacToeEngineReport& Report : Reports)
+	{
+		Ranked.Add(&Report);
+	}
+	Ranked.StableSort([](const FTicTacToeEngineReport& A, const FTicTacToeEngineReport& B) { return A.Elo > B.Elo; });
+
+	FString Output = FString::Printf(TEXT("%-24s %8s %8s %6s %6s %6s %6s %14s %12s\n"),
+		TEXT("Engine"), TEXT("Elo"), TEXT("+/-"), TEXT("Games"), TEXT("Won"), TEXT("Drawn"), TEXT("Lost"), TEXT("Nodes/sec"), TEXT("ms/move"));
+
+	for (const FTicTacToeEngineReport* Report : Ranked)
+	{
+		Output += FString::Printf(TEXT("%-24s %8.1f %8.1f %6d %6d %6d %6d %14.0f %12.4f\n"),
+			*Report->Name, Report->Elo, Report->EloMargin, Report->Games, Report->Wins, Report->Draws, Report->Losses,
+			Report->GetNodesPerSecond(), Report->GetSecondsPerMove() * 1000.0);
+	}
+	return Output;
+}
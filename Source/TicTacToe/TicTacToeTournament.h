@@ -0,0 +1,135 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeAI.h"
+
+/** Which engines meet each other */
+enum class ETicTacToeTournamentFormat : uint8
+{
+	/** Every engine plays every other engine */
+	RoundRobin,
+	/** The first engine plays each of the others */
+	Gauntlet
+};
+
+/** Who moves first in the next game of a pairing */
+enum class ETicTacToeFirstMoveRule : uint8
+{
+	/** Engines take turns moving first */
+	Alternate,
+	/** The last game's winner moves first, as ATicTacToeBlockGrid::SwitchPlayersByWin does. After a draw the turn carries on. */
+	WinnerMovesFirst
+};
+
+struct TICTACTOE_API FTicTacToeTournamentSettings
+{
+	FTicTacToeTournamentSettings()
+		: Format(ETicTacToeTournamentFormat::RoundRobin)
+		, FirstMoveRule(ETicTacToeFirstMoveRule::Alternate)
+		, GamesPerPairing(100)
+		, GamesPerBatch(10)
+		, BoardSize(3)
+		, WinLength(3)
+		, Seed(0)
+	{
+	}
+
+	TArray<FTicTacToeEngineSettings> Engines;
+
+	ETicTacToeTournamentFormat Format;
+
+	ETicTacToeFirstMoveRule FirstMoveRule;
+
+	/** Games played between each pair of engines */
+	int32 GamesPerPairing;
+
+	/**
+	 * Games run back to back on one worker. Each batch is seeded independently so results do not depend on the thread count.
+	 * Under WinnerMovesFirst each pairing is played as one batch, as every game decides who starts the next.
+	 */
+	int32 GamesPerBatch;
+
+	int32 BoardSize;
+
+	int32 WinLength;
+
+	/** Master seed, every game is reproducible from it */
+	int32 Seed;
+};
+
+/** Results for one engine */
+struct TICTACTOE_API FTicTacToeEngineReport
+{
+	FTicTacToeEngineReport() : Games(0), Wins(0), Draws(0), Losses(0), Elo(0.0), EloMargin(0.0), Moves(0), Nodes(0), SearchSeconds(0.0) { }
+
+	FString Name;
+
+	int32 Games;
+	int32 Wins;
+	int32 Draws;
+	int32 Losses;
+
+	/** Maximum likelihood rating, anchored so the field averages 0 */
+	double Elo;
+
+	/** Half width of the 95% confidence interval on Elo */
+	double EloMargin;
+
+	/** Moves made and the work spent on them */
+	int64 Moves;
+	int64 Nodes;
+	double SearchSeconds;
+
+	FORCEINLINE double GetNodesPerSecond() const { return SearchSeconds > 0.0 ? Nodes / SearchSeconds : 0.0; }
+	FORCEINLINE double GetSecondsPerMove() const { return Moves > 0 ? SearchSeconds / Moves : 0.0; }
+};
+
+/** Headless scheduler that plays engines against each other across all cores and rates them */
+class TICTACTOE_API FTicTacToeTournament
+{
+public:
+	explicit FTicTacToeTournament(const FTicTacToeTournamentSettings& InSettings);
+
+	/** Plays every scheduled game, blocking until done */
+	void Run();
+
+	/** Per engine results, valid after Run */
+	FORCEINLINE const TArray<FTicTacToeEngineReport>& GetReports() const { return Reports; }
+
+	/** Human readable results table */
+	FString FormatReport() const;
+
+private:
+
+	/** A run of consecutive games between two engines */
+	struct FBatch
+	{
+		int32 EngineA;
+		int32 EngineB;
+		int32 PairingIndex;
+		int32 BatchIndex;
+		int32 NumGames;
+
+		/** Filled in by the worker */
+		int32 WinsA;
+		int32 WinsB;
+		int32 Draws;
+		int64 Moves[2];
+		int64 Nodes[2];
+		double SearchSeconds[2];
+	};
+
+	void ScheduleBatches();
+
+	void PlayBatch(FBatch& Batch) const;
+
+	void ComputeRatings();
+
+	FTicTacToeTournamentSettings Settings;
+
+	TArray<FBatch> Batches;
+
+	TArray<FTicTacToeEngineReport> Reports;
+};
@@ -0,0 +1,78 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeTournamentCommandlet.h"
+#include "TicTacToe.h"
+#include "TicTacToeTournament.h"
+#include "HAL/PlatformTime.h"
+
+UTicTacToeTournamentCommandlet::UTicTacToeTournamentCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTicTacToeTournamentCommandlet::Main(const FString& Params)
+{
+	FTicTacToeTournamentSettings Settings;
+
+	FString EngineList = TEXT("Random,Tactical,AlphaBeta:4,MonteCarlo:500");
+	FParse::Value(*Params, TEXT("Engines="), EngineList, false);
+
+	TArray<FString> EngineSpecs;
+	EngineList.ParseIntoArray(EngineSpecs, TEXT(","));
+	for (const FString& Spec : EngineSpecs)
+	{
+		FTicTacToeEngineSettings& Engine = Settings.Engines.AddDefaulted_GetRef();
+		if (!FTicTacToeEngineSettings::Parse(Spec, Engine))
+		{
+			UE_LOG(LogTicTacToe, Error, TEXT("Unknown engine '%s'"), *Spec);
+			return 1;
+		}
+
+		// Helpers racing on the shared table would make games depend on thread timing, and every batch already has a core
+		if (Engine.Type == ETicTacToeEngineType::LazySMP && Engine.Threads > 1)
+		{
+			UE_LOG(LogTicTacToe, Warning, TEXT("'%s' plays on one thread so results stay reproducible"), *Spec);
+			Engine.Threads = 1;
+		}
+	}
+
+	if (Settings.Engines.Num() < 2)
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("A tournament needs at least two engines"));
+		return 1;
+	}
+
+	FString Format;
+	if (FParse::Value(*Params, TEXT("Format="), Format) && Format == TEXT("Gauntlet"))
+	{
+		Settings.Format = ETicTacToeTournamentFormat::Gauntlet;
+	}
+
+	FString FirstMove;
+	if (FParse::Value(*Params, TEXT("FirstMove="), FirstMove) && FirstMove == TEXT("Winner"))
+	{
+		Settings.FirstMoveRule = ETicTacToeFirstMoveRule::WinnerMovesFirst;
+	}
+
+	FParse::Value(*Params, TEXT("Games="), Settings.GamesPerPairing);
+	FParse::Value(*Params, TEXT("Batch="), Settings.GamesPerBatch);
+	FParse::Value(*Params, TEXT("Size="), Settings.BoardSize);
+	FParse::Value(*Params, TEXT("WinLength="), Settings.WinLength);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+
+	Settings.BoardSize = FMath::Clamp(Settings.BoardSize, 3, FTicTacToeLineTable::MaxSize);
+	Settings.WinLength = FMath::Clamp(Settings.WinLength, 3, Settings.BoardSize);
+
+	UE_LOG(LogTicTacToe, Display, TEXT("Tournament: %d engines, %dx%d board, %d in a row, %d games per pairing, seed %d"),
+		Settings.Engines.Num(), Settings.BoardSize, Settings.BoardSize, Settings.WinLength, Settings.GamesPerPairing, Settings.Seed);
+
+	const double StartTime = FPlatformTime::Seconds();
+	FTicTacToeTournament Tournament(Settings);
+	Tournament.Run();
+
+	UE_LOG(LogTicTacToe, Display, TEXT("Finished in %.2f s\n%s"), FPlatformTime::Seconds() - StartTime, *Tournament.FormatReport());
+	return 0;
+}
@@ -0,0 +1,28 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TicTacToeTournamentCommandlet.generated.h"
+
+/**
+ * Runs a headless bot tournament and logs Elo ratings. LazySMP engines search on one thread, so a
+ * seed always replays the same games.
+ *
+ * UE4Editor-Cmd TicTacToe -run=TicTacToeTournament -Engines=Random,Tactical,AlphaBeta:4,MonteCarlo:500
+ *     [-Format=RoundRobin|Gauntlet] [-FirstMove=Alternate|Winner] [-Games=100] [-Batch=10]
+ *     [-Size=3] [-WinLength=3] [-Seed=0]
+ */
+UCLASS()
+class UTicTacToeTournamentCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTicTacToeTournamentCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
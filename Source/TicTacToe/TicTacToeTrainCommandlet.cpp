@@ -0,0 +1,76 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeTrainCommandlet.h"
+#include "TicTacToe.h"
+#include "TicTacToeNTupleNetwork.h"
+#include "HAL/PlatformTime.h"
+
+UTicTacToeTrainCommandlet::UTicTacToeTrainCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UTicTacToeTrainCommandlet::Main(const FString& Params)
+{
+	int32 Size = 3;
+	int32 WinLength = 3;
+	FParse::Value(*Params, TEXT("Size="), Size);
+	FParse::Value(*Params, TEXT("WinLength="), WinLength);
+	Size = FMath::Clamp(Size, 3, FTicTacToeLineTable::MaxSize);
+	WinLength = FMath::Clamp(WinLength, 3, Size);
+
+	FTicTacToeNTupleTrainingSettings Settings;
+	FParse::Value(*Params, TEXT("Games="), Settings.Games);
+	FParse::Value(*Params, TEXT("Rate="), Settings.LearningRate);
+	FParse::Value(*Params, TEXT("Exploration="), Settings.Exploration);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+
+	FString Output = FTicTacToeNTupleNetwork::GetDefaultPath(Size, WinLength);
+	FParse::Value(*Params, TEXT("Output="), Output);
+
+	TUniquePtr<FTicTacToeNTupleNetwork> Network;
+	if (FParse::Param(*Params, TEXT("Resume")))
+	{
+		Network = FTicTacToeNTupleNetwork::Load(Output);
+		if (!Network.IsValid() || Network->GetSize() != Size || Network->GetWinLength() != WinLength)
+		{
+			UE_LOG(LogTicTacToe, Error, TEXT("Cannot resume from '%s'"), *Output);
+			return 1;
+		}
+	}
+	else
+	{
+		Network = MakeUnique<FTicTacToeNTupleNetwork>(Size, WinLength);
+	}
+
+	UE_LOG(LogTicTacToe, Display, TEXT("Training %dx%d, %d in a row: %d weights, %d games, seed %d"),
+		Size, Size, WinLength, Network->GetNumWeights(), Settings.Games, Settings.Seed);
+
+	// Ten progress reports over the run
+	const double StartTime = FPlatformTime::Seconds();
+	FTicTacToeNTupleTrainer Trainer(*Network, Settings);
+	const int32 GamesPerReport = FMath::Max(1, Settings.Games / 10);
+	while (Trainer.GetGamesPlayed() < Settings.Games)
+	{
+		const int32 Count = FMath::Min(GamesPerReport, Settings.Games - Trainer.GetGamesPlayed());
+		Trainer.Train(Count);
+
+		int32 Wins, Draws, Losses;
+		Trainer.ConsumeResults(Wins, Draws, Losses);
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+		UE_LOG(LogTicTacToe, Display, TEXT("%8d games  Player 1 %5.1f%%  draws %5.1f%%  Player 2 %5.1f%%  %8.0f games/sec"),
+			Trainer.GetGamesPlayed(), 100.0 * Wins / Count, 100.0 * Draws / Count, 100.0 * Losses / Count, Trainer.GetGamesPlayed() / FMath::Max(Seconds, 1e-6));
+	}
+
+	if (!Network->Save(Output))
+	{
+		UE_LOG(LogTicTacToe, Error, TEXT("Failed to write '%s'"), *Output);
+		return 1;
+	}
+
+	UE_LOG(LogTicTacToe, Display, TEXT("Wrote '%s'"), *Output);
+	return 0;
+}
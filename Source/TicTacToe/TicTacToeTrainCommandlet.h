@@ -0,0 +1,27 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TicTacToeTrainCommandlet.generated.h"
+
+/**
+ * Trains the n-tuple network of one Classic board shape by self-play and writes its weight file,
+ * by default where the AI looks for it. -Resume continues from the existing file.
+ *
+ * UE4Editor-Cmd TicTacToe -run=TicTacToeTrain -Size=5 -WinLength=4 [-Games=100000]
+ *     [-Rate=0.01] [-Exploration=0.1] [-Seed=0] [-Output=Path] [-Resume]
+ */
+UCLASS()
+class UTicTacToeTrainCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTicTacToeTrainCommandlet();
+
+	// Begin UCommandlet interface
+	virtual int32 Main(const FString& Params) override;
+	// End UCommandlet interface
+};
@@ -0,0 +1,72 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeTranspositionTable.h"
+
+namespace
+{
+	/** Score in the low 32 bits, then depth, bound and move a byte each */
+	FORCEINLINE uint64 Pack(const FTicTacToeTableEntry& Entry)
+	{
+		return uint64(uint32(Entry.Score))
+			| uint64(uint8(FMath::Clamp(Entry.Depth, 0, 255))) << 32
+			| uint64(Entry.Bound) << 40
+			| uint64(uint8(Entry.BestMove)) << 48;
+	}
+
+	FORCEINLINE FTicTacToeTableEntry Unpack(uint64 Data)
+	{
+		FTicTacToeTableEntry Entry;
+		Entry.Score = int32(uint32(Data));
+		Entry.Depth = int32((Data >> 32) & 0xFF);
+		Entry.Bound = ETicTacToeBound((Data >> 40) & 0xFF);
+		const uint8 Move = uint8(Data >> 48);
+		Entry.BestMove = Move == 0xFF ? INDEX_NONE : Move;
+		return Entry;
+	}
+}
+
+FTicTacToeTranspositionTable::FTicTacToeTranspositionTable(int32 SizeBits)
+{
+	SizeBits = FMath::Clamp(SizeBits, 1, 30);
+	NumSlots = 1 << SizeBits;
+	Shift = 64 - SizeBits;
+	Slots = MakeUnique<FSlot[]>(NumSlots);
+	Clear();
+}
+
+bool FTicTacToeTranspositionTable::Probe(uint64 Key, FTicTacToeTableEntry& OutEntry) const
+{
+	const FSlot& Slot = GetSlot(Key);
+	const uint64 Data = Slot.Data.Load(EMemoryOrder::Relaxed);
+	const uint64 Check = Slot.Check.Load(EMemoryOrder::Relaxed);
+
+	// Also rejects empty slots, which hold a zero check and no key hashes to zero in practice
+	if ((Check ^ Data) != Key)
+		return false;
+
+	OutEntry = Unpack(Data);
+	return true;
+}
+
+void FTicTacToeTranspositionTable::Store(uint64 Key, const FTicTacToeTableEntry& Entry)
+{
+	FSlot& Slot = GetSlot(Key);
+
+	// Depth preferred for the same position, always replace for a different one
+	const uint64 OldData = Slot.Data.Load(EMemoryOrder::Relaxed);
+	if ((Slot.Check.Load(EMemoryOrder::Relaxed) ^ OldData) == Key && Unpack(OldData).Depth > Entry.Depth)
+		return;
+
+	const uint64 Data = Pack(Entry);
+	Slot.Data.Store(Data, EMemoryOrder::Relaxed);
+	Slot.Check.Store(Key ^ Data, EMemoryOrder::Relaxed);
+}
+
+void FTicTacToeTranspositionTable::Clear()
+{
+	for (int32 Index = 0; Index < NumSlots; Index++)
+	{
+		Slots[Index].Data.Store(0, EMemoryOrder::Relaxed);
+		Slots[Index].Check.Store(0, EMemoryOrder::Relaxed);
+	}
+}
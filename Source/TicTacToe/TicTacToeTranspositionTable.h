@@ -0,0 +1,71 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+
+/** How a stored score relates to the position's true value */
+enum class ETicTacToeBound : uint8
+{
+	/** The score is the value */
+	Exact,
+	/** The value is at least the score, the search failed high */
+	Lower,
+	/** The value is at most the score, the search failed low */
+	Upper
+};
+
+/** One stored search result */
+struct FTicTacToeTableEntry
+{
+	int32 Score;
+
+	/** Remaining depth the score was searched to */
+	int32 Depth;
+
+	ETicTacToeBound Bound;
+
+	/** Best or refuting move found, INDEX_NONE for none */
+	int32 BestMove;
+};
+
+/**
+ * Lock-free hash table of search results that any number of threads may probe and store into.
+ * Each slot holds the packed entry and the entry XORed with the position key, written without
+ * locks. A slot torn by two threads writing at once fails the check and reads as a miss.
+ */
+class TICTACTOE_API FTicTacToeTranspositionTable
+{
+public:
+	/** 2^SizeBits slots of 16 bytes */
+	explicit FTicTacToeTranspositionTable(int32 SizeBits = 18);
+
+	/** Finds the entry stored for Key, returning false on a miss */
+	bool Probe(uint64 Key, FTicTacToeTableEntry& OutEntry) const;
+
+	/** Stores an entry, keeping a deeper entry already stored for the same position. Moves must fit in a byte. */
+	void Store(uint64 Key, const FTicTacToeTableEntry& Entry);
+
+	/** Forget every entry. Not safe while other threads use the table. */
+	void Clear();
+
+	FORCEINLINE int32 GetNumSlots() const { return NumSlots; }
+
+private:
+
+	struct FSlot
+	{
+		/** Key ^ Data */
+		TAtomic<uint64> Check;
+		TAtomic<uint64> Data;
+	};
+
+	FORCEINLINE FSlot& GetSlot(uint64 Key) const { return Slots[Key >> Shift]; }
+
+	TUniquePtr<FSlot[]> Slots;
+	int32 NumSlots;
+
+	/** Top bits of the key pick the slot */
+	int32 Shift;
+};
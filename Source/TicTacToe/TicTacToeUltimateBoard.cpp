@@ -0,0 +1,379 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "TicTacToeUltimateBoard.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	/** Lookup tables over every 9 bit sub-board mask */
+	struct FSubBoardTables
+	{
+		/** First completed line in a mask, or 0 */
+		uint16 WinningLine[512];
+
+		/** Index of the Nth set bit of a mask */
+		uint8 NthBit[512][9];
+
+		FSubBoardTables()
+		{
+			static const uint16 Lines[8] = { 0007, 0070, 0700, 0111, 0222, 0444, 0421, 0124 };
+
+			for (uint32 Mask = 0; Mask < 512; Mask++)
+			{
+				WinningLine[Mask] = 0;
+				for (uint16 Line : Lines)
+				{
+					if ((Mask & Line) == Line)
+					{
+						WinningLine[Mask] = Line;
+						break;
+					}
+				}
+
+				int32 Count = 0;
+				for (int32 Bit = 0; Bit < 9; Bit++)
+				{
+					NthBit[Mask][Bit] = 0;
+					if ((Mask >> Bit) & 1)
+					{
+						NthBit[Mask][Count++] = Bit;
+					}
+				}
+			}
+		}
+	};
+
+	const FSubBoardTables& GetTables()
+	{
+		static const FSubBoardTables Tables;
+		return Tables;
+	}
+
+	/** Exploration constant for UCT selection */
+	constexpr float ExplorationWeight = 1.2f;
+}
+
+FTicTacToeUltimateBoard::FTicTacToeUltimateBoard()
+{
+	Reset();
+}
+
+void FTicTacToeUltimateBoard::Reset()
+{
+	FMemory::Memzero(Cells);
+	Won[0] = Won[1] = 0;
+	Closed = 0;
+	ForcedSubBoard = INDEX_NONE;
+	MoveCount = 0;
+	Result = ETicTacToeResult::InProgress;
+}
+
+void FTicTacToeUltimateBoard::MakeMove(int32 Move)
+{
+	checkSlow(IsLegal(Move));
+
+	const FSubBoardTables& Tables = GetTables();
+	const int32 Player = GetSideToMove();
+	const int32 SubBoard = Move / 9;
+	const int32 Cell = Move % 9;
+
+	Cells[Player][SubBoard] |= 1 << Cell;
+	MoveCount++;
+
+	if (Tables.WinningLine[Cells[Player][SubBoard]])
+	{
+		Won[Player] |= 1 << SubBoard;
+		Closed |= 1 << SubBoard;
+
+		if (Tables.WinningLine[Won[Player]])
+		{
+			Result = Player == 0 ? ETicTacToeResult::Player1Win : ETicTacToeResult::Player2Win;
+		}
+	}
+	else if (GetEmptyCells(SubBoard) == 0)
+	{
+		Closed |= 1 << SubBoard;
+	}
+
+	if (Result == ETicTacToeResult::InProgress && Closed == FullSubBoard)
+	{
+		Result = ETicTacToeResult::Draw;
+	}
+
+	// The cell played picks the next sub-board, unless it is already decided
+	ForcedSubBoard = (Closed >> Cell) & 1 ? INDEX_NONE : Cell;
+}
+
+int32 FTicTacToeUltimateBoard::GenerateMoves(uint8* OutMoves) const
+{
+	const FSubBoardTables& Tables = GetTables();
+
+	int32 NumMoves = 0;
+	for (uint32 SubBoards = GetPlayableSubBoards(); SubBoards; SubBoards &= SubBoards - 1)
+	{
+		const int32 SubBoard = FMath::CountTrailingZeros(SubBoards);
+		const uint32 Empty = GetEmptyCells(SubBoard);
+		const int32 Count = FMath::CountBits(Empty);
+		for (int32 Index = 0; Index < Count; Index++)
+		{
+			OutMoves[NumMoves++] = SubBoard * 9 + Tables.NthBit[Empty][Index];
+		}
+	}
+	return NumMoves;
+}
+
+bool FTicTacToeUltimateBoard::IsLegal(int32 Move) const
+{
+	if (IsGameOver() || Move < 0 || Move >= 81)
+		return false;
+
+	const int32 SubBoard = Move / 9;
+	return ((GetPlayableSubBoards() >> SubBoard) & 1) && ((GetEmptyCells(SubBoard) >> (Move % 9)) & 1);
+}
+
+ETicTacToeResult FTicTacToeUltimateBoard::RandomPlayout(FRandomStream& Random, int64& OutMoves)
+{
+	const FSubBoardTables& Tables = GetTables();
+
+	while (!IsGameOver())
+	{
+		int32 Move;
+		if (ForcedSubBoard != INDEX_NONE)
+		{
+			const uint32 Empty = GetEmptyCells(ForcedSubBoard);
+			Move = ForcedSubBoard * 9 + Tables.NthBit[Empty][Random.RandHelper(FMath::CountBits(Empty))];
+		}
+		else
+		{
+			// Pick uniformly among every empty cell of every open sub-board
+			const uint32 Open = ~Closed & FullSubBoard;
+			int32 Total = 0;
+			for (uint32 SubBoards = Open; SubBoards; SubBoards &= SubBoards - 1)
+			{
+				Total += FMath::CountBits(GetEmptyCells(FMath::CountTrailingZeros(SubBoards)));
+			}
+
+			int32 Pick = Random.RandHelper(Total);
+			Move = INDEX_NONE;
+			for (uint32 SubBoards = Open; SubBoards; SubBoards &= SubBoards - 1)
+			{
+				const int32 SubBoard = FMath::CountTrailingZeros(SubBoards);
+				const uint32 Empty = GetEmptyCells(SubBoard);
+				const int32 Count = FMath::CountBits(Empty);
+				if (Pick < Count)
+				{
+					Move = SubBoard * 9 + Tables.NthBit[Empty][Pick];
+					break;
+				}
+				Pick -= Count;
+			}
+		}
+
+		MakeMove(Move);
+		OutMoves++;
+	}
+	return Result;
+}
+
+int32 FTicTacToeUltimateBoard::MoveFromGridIndex(int32 GridIndex)
+{
+	const int32 Row = GridIndex / 9;
+	const int32 Column = GridIndex % 9;
+	return ((Row / 3) * 3 + Column / 3) * 9 + (Row % 3) * 3 + Column % 3;
+}
+
+int32 FTicTacToeUltimateBoard::GridIndexFromMove(int32 Move)
+{
+	const int32 SubBoard = Move / 9;
+	const int32 Cell = Move % 9;
+	return ((SubBoard / 3) * 3 + Cell / 3) * 9 + (SubBoard % 3) * 3 + Cell % 3;
+}
+
+bool FTicTacToeUltimateBoard::IsWinningMask(uint32 Mask)
+{
+	return GetTables().WinningLine[Mask & FullSubBoard] != 0;
+}
+
+uint32 FTicTacToeUltimateBoard::GetWinningLine(uint32 Mask)
+{
+	return GetTables().WinningLine[Mask & FullSubBoard];
+}
+
+FTicTacToeUltimateAI::FTicTacToeUltimateAI(int32 InIterations)
+	: Iterations(InIterations)
+	, Control(nullptr)
+{
+}
+
+int32 FTicTacToeUltimateAI::ChooseMove(const FTicTacToeUltimateBoard& Board, FRandomStream& Random, FTicTacToeSearchStats& OutStats)
+{
+	uint8 Moves[81];
+	const int32 NumMoves = Board.GenerateMoves(Moves);
+
+	// Take an immediate win without searching
+	for (int32 Index = 0; Index < NumMoves; Index++)
+	{
+		FTicTacToeUltimateBoard Child = Board;
+		Child.MakeMove(Moves[Index]);
+		OutStats.Nodes++;
+		if (Child.IsGameOver() && Child.Result != ETicTacToeResult::Draw)
+			return Moves[Index];
+	}
+
+	if (NumMoves == 1)
+		return Moves[0];
+
+	Nodes.Reset();
+	Nodes.Add({ INDEX_NONE, 0, 0.f, 0, 0 });
+	Expand(0, Board);
+
+	const int32 RootSide = Board.GetSideToMove();
+	TArray<int32, TInlineAllocator<96>> Path;
+
+	const double StartTime = FPlatformTime::Seconds();
+	double NextReportTime = StartTime + (Control ? Control->ProgressInterval : 0.0);
+	int32 ReportedChild = INDEX_NONE;
+
+	for (int32 Iteration = 0; Iteration < Iterations; Iteration++)
+	{
+		// Stop checks and reports every few iterations keep the clock off the hot path
+		if (Control && (Iteration & 15) == 0)
+		{
+			if (Control->ShouldStop())
+				break;
+
+			// Report on a change of best move too, so a caller's best-so-far is never stale
+			const double Now = FPlatformTime::Seconds();
+			const int32 BestChild = GetBestChild(0);
+			if (Now >= NextReportTime || BestChild != ReportedChild)
+			{
+				ReportProgress(OutStats.Nodes, Now - StartTime);
+				NextReportTime = Now + Control->ProgressInterval;
+				ReportedChild = BestChild;
+			}
+		}
+
+		FTicTacToeUltimateBoard Work = Board;
+		Path.Reset();
+		Path.Add(0);
+
+		// Selection by UCT down to a leaf
+		int32 NodeIndex = 0;
+		while (Nodes[NodeIndex].FirstChild != INDEX_NONE && !Work.IsGameOver())
+		{
+			const FNode& Parent = Nodes[NodeIndex];
+			const float LogVisits = FMath::Loge(float(FMath::Max(1, Parent.Visits)));
+
+			int32 BestChild = Parent.FirstChild;
+			float BestValue = -1.f;
+			for (int32 Child = Parent.FirstChild; Child < Parent.FirstChild + Parent.NumChildren; Child++)
+			{
+				const FNode& Node = Nodes[Child];
+				if (Node.Visits == 0)
+				{
+					BestChild = Child;
+					break;
+				}
+
+				const float Value = Node.Reward / Node.Visits + ExplorationWeight * FMath::Sqrt(LogVisits / Node.Visits);
+				if (Value > BestValue)
+				{
+					BestValue = Value;
+					BestChild = Child;
+				}
+			}
+
+			NodeIndex = BestChild;
+			Work.MakeMove(Nodes[NodeIndex].Move);
+			Path.Add(NodeIndex);
+		}
+
+		// Expansion of one new node per iteration
+		if (!Work.IsGameOver() && Nodes[NodeIndex].Visits > 0 && Nodes.Num() + 81 <= MaxTreeNodes)
+		{
+			NodeIndex = Expand(NodeIndex, Work);
+			Work.MakeMove(Nodes[NodeIndex].Move);
+			Path.Add(NodeIndex);
+		}
+
+		const ETicTacToeResult Result = Work.IsGameOver() ? Work.Result : Work.RandomPlayout(Random, OutStats.Nodes);
+
+		// Backpropagation, each node is scored for the player who moved into it
+		for (int32 Depth = 0; Depth < Path.Num(); Depth++)
+		{
+			FNode& Node = Nodes[Path[Depth]];
+			Node.Visits++;
+
+			const int32 Mover = (RootSide + Depth + 1) & 1;
+			if (Result == ETicTacToeResult::Draw)
+				Node.Reward += 0.5f;
+			else if ((Result == ETicTacToeResult::Player1Win) == (Mover == 0))
+				Node.Reward += 1.f;
+		}
+	}
+
+	if (Control)
+	{
+		ReportProgress(OutStats.Nodes, FPlatformTime::Seconds() - StartTime);
+	}
+	return Nodes[GetBestChild(0)].Move;
+}
+
+int32 FTicTacToeUltimateAI::GetBestChild(int32 NodeIndex) const
+{
+	const FNode& Parent = Nodes[NodeIndex];
+	int32 BestChild = Parent.FirstChild;
+	for (int32 Child = Parent.FirstChild; Child < Parent.FirstChild + Parent.NumChildren; Child++)
+	{
+		if (Nodes[Child].Visits > Nodes[BestChild].Visits)
+		{
+			BestChild = Child;
+		}
+	}
+	return BestChild;
+}
+
+void FTicTacToeUltimateAI::ReportProgress(int64 NumNodes, double Seconds) const
+{
+	FTicTacToeSearchProgress Progress;
+	Progress.Nodes = NumNodes;
+	Progress.Seconds = Seconds;
+
+	// Follow the most visited children while they have been tried
+	for (int32 NodeIndex = 0; Nodes[NodeIndex].FirstChild != INDEX_NONE; )
+	{
+		NodeIndex = GetBestChild(NodeIndex);
+		const FNode& Node = Nodes[NodeIndex];
+		if (Node.Visits == 0)
+			break;
+
+		if (Progress.PrincipalVariation.Num() == 0)
+		{
+			Progress.Score = FMath::RoundToInt(2000.f * Node.Reward / Node.Visits) - 1000;
+		}
+		Progress.PrincipalVariation.Add(Node.Move);
+	}
+
+	if (Progress.PrincipalVariation.Num() == 0)
+		return;
+
+	Progress.Depth = Progress.PrincipalVariation.Num();
+	Progress.BestMove = Progress.PrincipalVariation[0];
+	Control->ReportProgress(Progress);
+}
+
+int32 FTicTacToeUltimateAI::Expand(int32 NodeIndex, const FTicTacToeUltimateBoard& Board)
+{
+	uint8 Moves[81];
+	const int32 NumMoves = Board.GenerateMoves(Moves);
+
+	const int32 FirstChild = Nodes.Num();
+	for (int32 Index = 0; Index < NumMoves; Index++)
+	{
+		Nodes.Add({ INDEX_NONE, 0, 0.f, 0, Moves[Index] });
+	}
+
+	Nodes[NodeIndex].FirstChild = FirstChild;
+	Nodes[NodeIndex].NumChildren = NumMoves;
+	return FirstChild;
+}
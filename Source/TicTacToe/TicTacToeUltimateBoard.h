@@ -0,0 +1,123 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TicTacToeAI.h"
+
+/**
+ * Ultimate Tic-Tac-Toe rules core: a 3x3 macro board of 3x3 sub-boards, where the cell a
+ * player picks inside a sub-board sends the opponent to the matching sub-board.
+ *
+ * Each sub-board is a 9 bit mask per player and the macro board is another 9 bit mask of
+ * captured sub-boards, so every rules question is answered by a 512 entry table lookup.
+ * Moves are encoded as SubBoard * 9 + Cell. The struct is small enough to copy per node.
+ */
+struct TICTACTOE_API FTicTacToeUltimateBoard
+{
+	FTicTacToeUltimateBoard();
+
+	/** Clear all marks, Player 1 to move anywhere */
+	void Reset();
+
+	/** Play a legal move for the side to move */
+	void MakeMove(int32 Move);
+
+	/** Fills OutMoves with every legal move, returning the count (at most 81) */
+	int32 GenerateMoves(uint8* OutMoves) const;
+
+	/** Is Move legal in this position? */
+	bool IsLegal(int32 Move) const;
+
+	/** Plays random moves until the game ends, returning the result */
+	ETicTacToeResult RandomPlayout(FRandomStream& Random, int64& OutMoves);
+
+	/** Empty cells of a sub-board */
+	FORCEINLINE uint32 GetEmptyCells(int32 SubBoard) const { return ~(Cells[0][SubBoard] | Cells[1][SubBoard]) & FullSubBoard; }
+
+	/** Sub-boards a move may currently be played in */
+	FORCEINLINE uint32 GetPlayableSubBoards() const
+	{
+		return ForcedSubBoard != INDEX_NONE ? 1u << ForcedSubBoard : ~Closed & FullSubBoard;
+	}
+
+	FORCEINLINE int32 GetSideToMove() const { return MoveCount & 1; }
+
+	FORCEINLINE bool IsGameOver() const { return Result != ETicTacToeResult::InProgress; }
+
+	/** Converts between moves and row-major indices on the 9x9 block grid */
+	static int32 MoveFromGridIndex(int32 GridIndex);
+	static int32 GridIndexFromMove(int32 Move);
+
+	/** Does a 9 bit mask hold three in a row? */
+	static bool IsWinningMask(uint32 Mask);
+
+	/** Returns the winning line inside a 9 bit mask, or 0 */
+	static uint32 GetWinningLine(uint32 Mask);
+
+	/** Mask of all nine cells or sub-boards */
+	static constexpr uint32 FullSubBoard = 0x1FF;
+
+	/** Marks per player per sub-board */
+	uint16 Cells[2][9];
+
+	/** Sub-boards captured per player */
+	uint16 Won[2];
+
+	/** Sub-boards that are captured or full */
+	uint16 Closed;
+
+	/** Sub-board the side to move must play in, or INDEX_NONE for any open one */
+	int8 ForcedSubBoard;
+
+	/** Moves played so far */
+	uint8 MoveCount;
+
+	/** Result after the last move */
+	ETicTacToeResult Result;
+};
+
+/** Monte Carlo tree search player for Ultimate Tic-Tac-Toe */
+class TICTACTOE_API FTicTacToeUltimateAI
+{
+public:
+	explicit FTicTacToeUltimateAI(int32 InIterations = 20000);
+
+	/** Returns the chosen move. Board must not be game over. */
+	int32 ChooseMove(const FTicTacToeUltimateBoard& Board, FRandomStream& Random, FTicTacToeSearchStats& OutStats);
+
+	/** Playouts per move */
+	int32 Iterations;
+
+	/** Optional deadline, stop flag and progress reporting */
+	const FTicTacToeSearchControl* Control;
+
+	/** Tree size past which leaves are no longer expanded, bounding memory on long searches */
+	static constexpr int32 MaxTreeNodes = 1 << 22;
+
+private:
+
+	struct FNode
+	{
+		/** Index of the first child in Nodes, or INDEX_NONE before expansion */
+		int32 FirstChild;
+
+		/** Visit count and total reward for the player who moved into this node */
+		int32 Visits;
+		float Reward;
+
+		uint8 NumChildren;
+		uint8 Move;
+	};
+
+	/** Tree storage reused across moves, children of a node are contiguous */
+	TArray<FNode> Nodes;
+
+	int32 Expand(int32 NodeIndex, const FTicTacToeUltimateBoard& Board);
+
+	/** Most visited child of a node */
+	int32 GetBestChild(int32 NodeIndex) const;
+
+	/** Report the most visited line through the tree to Control */
+	void ReportProgress(int64 NumNodes, double Seconds) const;
+};